@@ -0,0 +1,178 @@
+#include "Agregacion.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+#include "FechaSimd.h"
+
+void edad::sumar_histograma(Histograma& destino, const Histograma& origen) noexcept {
+    for (std::size_t edad = 0u; edad < destino.size(); ++edad) {
+        destino[edad] += origen[edad];
+    }
+}
+
+void edad::imprimir_histograma(const Histograma& histograma, std::ostream& salida) {
+    for (std::size_t edad = 0u; edad < histograma.size(); ++edad) {
+        if (histograma[edad] != 0u) {
+            salida << "La edad " << edad << " tiene " << histograma[edad] << " ocurrencias\n";
+        }
+    }
+}
+
+void edad::imprimir_descartes(std::uint64_t invalidas, std::uint64_t fuera_rango, std::ostream& salida) {
+    salida << "Líneas inválidas: " << invalidas << "\n";
+    salida << "Edades fuera de [0," << EDAD_MAXIMA << "]: " << fuera_rango << "\n";
+}
+
+edad::ConteoFechas::ConteoFechas(long long dia_inicial, std::size_t dias)
+: dia_inicial_(dia_inicial), conteos_(dias, 0u) {
+}
+
+edad::ConteoFechas::ConteoFechas(const Calculadora& calculadora)
+: ConteoFechas(calculadora.dias_referencia() - static_cast<long long> (calculadora.dias_tabla()) + 1,
+calculadora.dias_tabla()) {
+}
+
+edad::ConteoFechas::ConteoFechas(const std::vector<Calculadora>& calculadoras)
+: ConteoFechas(calculadoras.front()) {
+    long long primero = dia_inicial_;
+    long long ultimo = dia_inicial_ + static_cast<long long> (conteos_.size());
+    for (const Calculadora& calculadora : calculadoras) {
+        primero = std::min(primero, calculadora.dias_referencia() - static_cast<long long> (calculadora.dias_tabla()) + 1);
+        ultimo = std::max(ultimo, calculadora.dias_referencia() + 1);
+    }
+    dia_inicial_ = primero;
+    conteos_.assign(static_cast<std::size_t> (ultimo - primero), 0u);
+}
+
+void edad::ConteoFechas::contar_lote(const std::string_view* fechas, std::size_t n) {
+    std::int32_t anios[LINEAS_POR_BLOQUE];
+    std::int32_t meses[LINEAS_POR_BLOQUE];
+    std::int32_t dias[LINEAS_POR_BLOQUE];
+    std::int32_t dias_nacimiento[LINEAS_POR_BLOQUE];
+    std::uint8_t validas[LINEAS_POR_BLOQUE];
+    std::uint64_t* conteos = conteos_.data();
+    const std::uint32_t limite = static_cast<std::uint32_t> (conteos_.size());
+    const std::uint32_t inicial = static_cast<std::uint32_t> (dia_inicial_);
+
+    for (std::size_t base = 0u; base < n; base += LINEAS_POR_BLOQUE) {
+        const std::size_t cantidad = std::min(LINEAS_POR_BLOQUE, n - base);
+        const std::size_t invalidas = parsear_fechas_lote(fechas + base, cantidad, anios, meses, dias, validas);
+        fechas_a_dias_lote(anios, meses, dias, cantidad, dias_nacimiento);
+        invalidas_ += invalidas;
+        validas_ += cantidad - invalidas;
+
+        // Igual que en Calculadora::clasificar_lote: un desfase negativo se vuelve enorme como sin signo.
+        for (std::size_t k = 0u; k < cantidad; ++k) {
+            if (validas[k] == 0u) {
+                continue;
+            }
+            const std::uint32_t desfase = static_cast<std::uint32_t> (dias_nacimiento[k]) - inicial;
+            if (desfase < limite) {
+                ++conteos[desfase];
+            } else {
+                ++fuera_ventana_[dias_nacimiento[k]];
+            }
+        }
+    }
+}
+
+void edad::ConteoFechas::combinar(const ConteoFechas& otro) {
+    if (otro.dia_inicial_ != dia_inicial_ || otro.conteos_.size() != conteos_.size()) {
+        throw std::invalid_argument("ConteoFechas::combinar: ventanas distintas");
+    }
+    for (std::size_t i = 0u; i < conteos_.size(); ++i) {
+        conteos_[i] += otro.conteos_[i];
+    }
+    for (const auto& [dia, ocurrencias] : otro.fuera_ventana_) {
+        fuera_ventana_[dia] += ocurrencias;
+    }
+    invalidas_ += otro.invalidas_;
+    validas_ += otro.validas_;
+}
+
+std::uint64_t edad::ConteoFechas::invalidas() const noexcept {
+    return invalidas_;
+}
+
+std::uint64_t edad::ConteoFechas::validas() const noexcept {
+    return validas_;
+}
+
+std::size_t edad::ConteoFechas::fechas_distintas() const noexcept {
+    return fuera_ventana_.size() + static_cast<std::size_t> (
+            std::count_if(conteos_.begin(), conteos_.end(), [](std::uint64_t c) {
+                return c != 0u;
+            }));
+}
+
+template <typename F>
+void edad::ConteoFechas::recorrer(F f) const {
+    // El mapa está ordenado: primero las fechas anteriores a la ventana, luego la ventana, luego las posteriores.
+    auto it = fuera_ventana_.begin();
+    for (; it != fuera_ventana_.end() && it->first < dia_inicial_; ++it) {
+        f(it->first, it->second);
+    }
+    for (std::size_t i = 0u; i < conteos_.size(); ++i) {
+        if (conteos_[i] != 0u) {
+            f(dia_inicial_ + static_cast<long long> (i), conteos_[i]);
+        }
+    }
+    for (; it != fuera_ventana_.end(); ++it) {
+        f(it->first, it->second);
+    }
+}
+
+std::uint64_t edad::ConteoFechas::acumular(const Calculadora& calculadora, Histograma& histograma) const {
+    std::uint64_t fuera_rango = 0u;
+    recorrer([&](long long dia, std::uint64_t ocurrencias) {
+        const std::int16_t clave = calculadora.clasificar_dias(dia);
+        if (clave == CLAVE_FUERA_RANGO) {
+            fuera_rango += ocurrencias;
+        } else {
+            histograma[static_cast<std::size_t> (clave)] += ocurrencias;
+        }
+    });
+    return fuera_rango;
+}
+
+void edad::ConteoFechas::escribir_csv(std::ostream& salida) const {
+    recorrer([&](long long dia, std::uint64_t ocurrencias) {
+        salida << formatear_fecha(dia) << ',' << ocurrencias << '\n';
+    });
+}
+
+bool edad::escribir_conteo_fechas(const ConteoFechas& conteo, const std::string& ruta) {
+    std::ofstream archivo(ruta);
+    if (archivo) {
+        conteo.escribir_csv(archivo);
+        archivo.flush();
+    }
+    if (!archivo) {
+        std::cerr << "No se pudo escribir el conteo por fecha en: " << ruta << "\n";
+        return false;
+    }
+    return true;
+}
+
+void edad::imprimir_por_referencia(const ConteoFechas& conteo, const std::vector<Calculadora>& calculadoras,
+        std::ostream& salida, std::ostream& resumen) {
+    if (calculadoras.size() == 1u) {
+        Histograma histograma{};
+        const std::uint64_t fuera_rango = conteo.acumular(calculadoras.front(), histograma);
+        imprimir_histograma(histograma, salida);
+        imprimir_descartes(conteo.invalidas(), fuera_rango, resumen);
+        return;
+    }
+    resumen << "Líneas inválidas: " << conteo.invalidas() << "\n";
+    for (const Calculadora& calculadora : calculadoras) {
+        const std::string referencia = formatear_fecha(calculadora.dias_referencia());
+        Histograma histograma{};
+        const std::uint64_t fuera_rango = conteo.acumular(calculadora, histograma);
+        salida << "# Referencia " << referencia << "\n";
+        imprimir_histograma(histograma, salida);
+        resumen << "Edades fuera de [0," << EDAD_MAXIMA << "] al " << referencia << ": " << fuera_rango << "\n";
+    }
+}
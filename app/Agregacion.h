@@ -0,0 +1,145 @@
+#ifndef AGREGACION_H
+#define AGREGACION_H
+
+/**
+ * @file Agregacion.h
+ * @brief Agregación en dos fases: conteo por fecha de nacimiento y conversión a edades una vez por fecha distinta.
+ *
+ * @details
+ * Un archivo de millones de líneas suele contener solo decenas de miles de fechas distintas. En lugar de
+ * clasificar cada línea en una edad, @ref ConteoFechas cuenta ocurrencias por número de día (según
+ * @ref fecha_a_dias) en un arreglo denso, y la conversión a edad (@ref Calculadora::clasificar_dias) se
+ * aplica después una sola vez por fecha distinta (@ref ConteoFechas::acumular).
+ *
+ * - **Fase 1 (por línea):** parseo y conversión a días vectorizados + un incremento en el arreglo denso.
+ *   Cada hilo usa su propio @ref ConteoFechas (sin atómicos ni mapa concurrente) y al final se combinan.
+ * - **Fase 2 (por fecha distinta):** histograma de edades y, opcionalmente, el conteo por fecha como CSV.
+ *   Como el conteo no depende de la fecha de referencia, una sola pasada sobre el archivo alcanza para
+ *   producir un histograma por cada fecha de referencia (@ref imprimir_por_referencia).
+ *
+ * La ventana densa cubre los días que pueden tener edad en [0, @ref EDAD_MAXIMA]; las fechas válidas fuera
+ * de ella (nacimientos futuros o muy antiguos, raras) se cuentan en un mapa aparte, de modo que el conteo
+ * por fecha es completo.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Edad.h"
+
+namespace edad {
+
+    /**
+     * @brief Ocurrencias por edad en [0, @ref EDAD_MAXIMA].
+     */
+    using Histograma = std::array<std::uint64_t, EDAD_MAXIMA + 1>;
+
+    /**
+     * @brief Suma @p origen a @p destino edad por edad (combinación de histogramas parciales por hilo o por tarea).
+     */
+    void sumar_histograma(Histograma& destino, const Histograma& origen) noexcept;
+
+    /**
+     * @brief Emite cada edad con ocurrencias > 0, en orden creciente ("La edad X tiene N ocurrencias").
+     */
+    void imprimir_histograma(const Histograma& histograma, std::ostream& salida);
+
+    /**
+     * @brief Emite el resumen de líneas descartadas (fecha inválida / edad fuera de [0, @ref EDAD_MAXIMA]).
+     */
+    void imprimir_descartes(std::uint64_t invalidas, std::uint64_t fuera_rango, std::ostream& salida);
+
+    /**
+     * @brief Conteo de ocurrencias por fecha de nacimiento.
+     *
+     * @details
+     * No es thread-safe: la idea es una instancia por hilo y @ref combinar al final. Todas las instancias
+     * que se combinan deben usar la misma ventana.
+     */
+    class ConteoFechas {
+    public:
+        /**
+         * @brief Conteo con ventana densa [dia_inicial, dia_inicial + dias).
+         */
+        ConteoFechas(long long dia_inicial, std::size_t dias);
+
+        /**
+         * @brief Conteo cuya ventana coincide con la tabla de edades de @p calculadora.
+         */
+        explicit ConteoFechas(const Calculadora& calculadora);
+
+        /**
+         * @brief Conteo cuya ventana cubre la unión de las tablas de edades de @p calculadoras (no vacío).
+         */
+        explicit ConteoFechas(const std::vector<Calculadora>& calculadoras);
+
+        /**
+         * @brief Cuenta @p n líneas (parseo y conversión a días vectorizados).
+         * @details Las líneas que no son una fecha válida solo incrementan @ref invalidas.
+         */
+        void contar_lote(const std::string_view* fechas, std::size_t n);
+
+        /**
+         * @brief Suma los conteos de @p otro (misma ventana) a esta instancia.
+         */
+        void combinar(const ConteoFechas& otro);
+
+        /// Líneas que no son una fecha válida.
+        std::uint64_t invalidas() const noexcept;
+
+        /// Líneas con una fecha válida.
+        std::uint64_t validas() const noexcept;
+
+        /// Cantidad de fechas distintas contadas.
+        std::size_t fechas_distintas() const noexcept;
+
+        /**
+         * @brief Fase 2: suma al @p histograma las ocurrencias de cada fecha según su edad en @p calculadora.
+         * @return Ocurrencias de fechas válidas cuya edad queda fuera de [0, @ref EDAD_MAXIMA].
+         */
+        std::uint64_t acumular(const Calculadora& calculadora, Histograma& histograma) const;
+
+        /**
+         * @brief Emite el conteo por fecha en orden cronológico, una línea "YYYY-MM-DD,N" por fecha distinta.
+         */
+        void escribir_csv(std::ostream& salida) const;
+
+    private:
+        /// Aplica @p f(dia, ocurrencias) a cada fecha con ocurrencias > 0, en orden cronológico.
+        template <typename F>
+        void recorrer(F f) const;
+
+        long long dia_inicial_;
+        std::vector<std::uint64_t> conteos_;
+        std::map<long long, std::uint64_t> fuera_ventana_;
+        std::uint64_t invalidas_ = 0u;
+        std::uint64_t validas_ = 0u;
+    };
+
+    /**
+     * @brief Escribe @ref ConteoFechas::escribir_csv de @p conteo en el archivo @p ruta.
+     * @return `true` si se pudo escribir; en caso contrario informa el problema por @c std::cerr y retorna `false`.
+     */
+    bool escribir_conteo_fechas(const ConteoFechas& conteo, const std::string& ruta);
+
+    /**
+     * @brief Fase 2 para una o más fechas de referencia: un histograma por calculadora, en orden.
+     *
+     * @param conteo Conteo por fecha (ya combinado).
+     * @param calculadoras Una calculadora por fecha de referencia (no vacío).
+     * @param salida Destino de los histogramas. Con más de una referencia, cada histograma va precedido de
+     *        una línea "# Referencia YYYY-MM-DD"; con una sola, la salida es idéntica a @ref imprimir_histograma.
+     * @param resumen Destino del resumen de descartes (@ref imprimir_descartes); con varias referencias, las
+     *        líneas inválidas se informan una vez y las edades fuera de rango una vez por referencia.
+     */
+    void imprimir_por_referencia(const ConteoFechas& conteo, const std::vector<Calculadora>& calculadoras,
+            std::ostream& salida, std::ostream& resumen);
+}
+
+#endif /* AGREGACION_H */
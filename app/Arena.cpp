@@ -0,0 +1,128 @@
+#include "Arena.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <new>
+
+namespace {
+
+    /**
+     * @brief Pendientes de una losa mientras su escritor la llena.
+     * @details Los consumidores pueden soltar líneas antes de que el escritor sepa cuántas tendrá la losa: la
+     *          cuenta arranca en este valor (nunca alcanzable por descuentos) y al sellar se le resta lo que
+     *          sobra sobre las líneas copiadas. Así solo llega a cero tras el sello y la última línea soltada.
+     */
+    constexpr std::int64_t ABIERTA = std::numeric_limits<std::int64_t>::max() / 2;
+
+    /// Bytes que ocupa en la losa una línea de @p longitud, con el encabezado y el relleno hasta el siguiente.
+    constexpr std::size_t ocupados(std::size_t longitud) noexcept {
+        constexpr std::size_t alineacion = alignof(edad::ArenaLineas::Linea);
+        return (sizeof(edad::ArenaLineas::Linea) + longitud + alineacion - 1u) / alineacion * alineacion;
+    }
+}
+
+struct edad::ArenaLineas::Losa {
+
+    explicit Losa(std::size_t bytes) : capacidad(bytes), datos(new char[bytes]) {
+    }
+
+    std::atomic<std::int64_t> pendientes{0};
+    const std::size_t capacidad;
+    // Un arreglo de char de 'new' está alineado para cualquier objeto que quepa en él (encabezados incluidos).
+    const std::unique_ptr<char[]> datos;
+};
+
+edad::ArenaLineas::Escritor::Escritor(ArenaLineas& arena) noexcept : arena_(arena) {
+}
+
+edad::ArenaLineas::Escritor::~Escritor() {
+    sellar();
+}
+
+edad::ArenaLineas::Linea* edad::ArenaLineas::Escritor::copiar(std::string_view linea) {
+    const std::size_t bytes = ocupados(linea.size());
+    if (losa_ == nullptr || usados_ + bytes > losa_->capacidad) {
+        sellar();
+        losa_ = arena_.tomar(bytes);
+    }
+    Linea* const registro = new (losa_->datos.get() + usados_) Linea{losa_, static_cast<std::uint32_t> (linea.size())};
+    std::memcpy(registro + 1, linea.data(), linea.size());
+    usados_ += bytes;
+    ++lineas_;
+    return registro;
+}
+
+void edad::ArenaLineas::Escritor::sellar() noexcept {
+    if (losa_ == nullptr) {
+        return;
+    }
+    const std::int64_t sobrante = ABIERTA - lineas_;
+    if (losa_->pendientes.fetch_sub(sobrante, std::memory_order_acq_rel) == sobrante) {
+        // Los consumidores ya soltaron todas sus líneas (o no tuvo ninguna).
+        arena_.reciclar(losa_);
+    }
+    losa_ = nullptr;
+    usados_ = 0u;
+    lineas_ = 0;
+}
+
+edad::ArenaLineas::ArenaLineas(std::size_t bytes_por_losa) : bytes_por_losa_(std::max(bytes_por_losa, ocupados(0u))) {
+}
+
+edad::ArenaLineas::~ArenaLineas() = default;
+
+void edad::ArenaLineas::soltar(Linea* const* lineas, std::size_t n) noexcept {
+    std::size_t desde = 0u;
+    while (desde < n) {
+        Losa* const losa = lineas[desde]->losa;
+        std::size_t hasta = desde + 1u;
+        while (hasta < n && lineas[hasta]->losa == losa) {
+            ++hasta;
+        }
+        // 'release' ordena la lectura de las líneas antes de que otro hilo reutilice la losa; 'acquire', para
+        // quien la recicla, las lecturas de los demás consumidores.
+        const std::int64_t cantidad = static_cast<std::int64_t> (hasta - desde);
+        if (losa->pendientes.fetch_sub(cantidad, std::memory_order_acq_rel) == cantidad) {
+            reciclar(losa);
+        }
+        desde = hasta;
+    }
+}
+
+std::size_t edad::ArenaLineas::losas() const {
+    std::lock_guard<std::mutex> cerrojo(mutex_);
+    return todas_.size();
+}
+
+std::size_t edad::ArenaLineas::bytes() const {
+    std::lock_guard<std::mutex> cerrojo(mutex_);
+    std::size_t total = 0u;
+    for (const std::unique_ptr<Losa>& losa : todas_) {
+        total += losa->capacidad;
+    }
+    return total;
+}
+
+edad::ArenaLineas::Losa* edad::ArenaLineas::tomar(std::size_t bytes) {
+    Losa* losa = nullptr;
+    {
+        std::lock_guard<std::mutex> cerrojo(mutex_);
+        if (!libres_.empty() && libres_.back()->capacidad >= bytes) {
+            losa = libres_.back();
+            libres_.pop_back();
+        } else {
+            todas_.push_back(std::make_unique<Losa>(std::max(bytes, bytes_por_losa_)));
+            // La lista libre admite todas las losas: 'reciclar' nunca reserva memoria.
+            libres_.reserve(todas_.size());
+            losa = todas_.back().get();
+        }
+    }
+    losa->pendientes.store(ABIERTA, std::memory_order_relaxed);
+    return losa;
+}
+
+void edad::ArenaLineas::reciclar(Losa* losa) noexcept {
+    std::lock_guard<std::mutex> cerrojo(mutex_);
+    libres_.push_back(losa);
+}
@@ -0,0 +1,128 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+/**
+ * @file Arena.h
+ * @brief Arena reciclable de líneas para el modo por línea del pipeline (`--lote=0`).
+ *
+ * @details
+ * En el modo por línea cada elemento de la cola es una línea que debe sobrevivir al búfer de lectura. Con un
+ * `new std::string` por línea, el lector reserva y cada consumidor libera memoria ajena: ≈10 M reservas y
+ * liberaciones cruzadas entre hilos en edades.csv, el camino más caro del *allocator*.
+ *
+ * Con @ref ArenaLineas el lector copia cada línea a continuación de la anterior en una **losa** (por omisión de
+ * `BYTES_POR_LOSA`) y encola un puntero a su @ref ArenaLineas::Linea. Cada losa cuenta sus líneas pendientes;
+ * los consumidores las devuelven por bloques (@ref ArenaLineas::soltar, un decremento atómico por losa del
+ * bloque) y quien deja la cuenta en cero devuelve la losa a la lista libre, de la que el lector la vuelve a
+ * llenar. Tras el arranque no hay memoria dinámica por línea ni por losa.
+ *
+ * @code{.cpp}
+ * edad::ArenaLineas arena;
+ * edad::ArenaLineas::Escritor escritor(arena);          // uno por lector
+ * cola.encolar(escritor.copiar(linea), productor);     // lector
+ * ...
+ * vistas[k] = lineas[k]->texto();                      // consumidor
+ * arena.soltar(lineas, n);                             // consumidor, al terminar el bloque
+ * @endcode
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+namespace edad {
+
+    /// Bytes de cada losa de @ref ArenaLineas (≈2000 líneas de fecha; las más largas reciben una losa a medida).
+    constexpr std::size_t BYTES_POR_LOSA = std::size_t{64} << 10;
+
+    /**
+     * @brief Losas reutilizables donde los lectores copian líneas que los consumidores devuelven por bloques.
+     *
+     * @details Thread-safe: varios @ref Escritor (uno por lector) y varios consumidores la usan a la vez. Las losas
+     *          se crean a demanda y viven hasta que se destruye la arena, que debe sobrevivir a toda línea copiada.
+     */
+    class ArenaLineas {
+        struct Losa;
+
+    public:
+
+        /**
+         * @brief Línea copiada en una losa; el texto sigue al encabezado en la misma losa.
+         * @details Válida hasta que se la suelta (@ref soltar).
+         */
+        struct Linea {
+            Losa* losa;
+            std::uint32_t longitud;
+
+            /// Texto de la línea.
+            std::string_view texto() const noexcept {
+                return std::string_view(reinterpret_cast<const char*> (this + 1), longitud);
+            }
+        };
+
+        /**
+         * @brief Copia líneas en la losa en curso de un lector. No es thread-safe: un escritor por hilo.
+         */
+        class Escritor {
+        public:
+            explicit Escritor(ArenaLineas& arena) noexcept;
+
+            /// Sella la losa en curso.
+            ~Escritor();
+
+            Escritor(const Escritor&) = delete;
+            Escritor& operator=(const Escritor&) = delete;
+
+            /// Copia @p linea en la losa en curso (o en otra, si no cabe) y retorna su registro.
+            Linea* copiar(std::string_view linea);
+
+            /// Cierra la losa en curso: desde ahora vuelve a la lista libre cuando se suelten todas sus líneas.
+            void sellar() noexcept;
+
+        private:
+            ArenaLineas& arena_;
+            Losa* losa_ = nullptr;
+            std::size_t usados_ = 0u;
+            std::int64_t lineas_ = 0;
+        };
+
+        /// Arena sin losas; cada losa tendrá al menos @p bytes_por_losa bytes.
+        explicit ArenaLineas(std::size_t bytes_por_losa = BYTES_POR_LOSA);
+
+        ~ArenaLineas();
+
+        ArenaLineas(const ArenaLineas&) = delete;
+        ArenaLineas& operator=(const ArenaLineas&) = delete;
+
+        /**
+         * @brief Devuelve las @p n líneas de @p lineas, ya procesadas.
+         * @details Las líneas consecutivas de una misma losa (lo habitual) se descuentan con una sola operación
+         *          atómica; la losa que queda sin líneas pendientes vuelve a la lista libre.
+         */
+        void soltar(Linea* const* lineas, std::size_t n) noexcept;
+
+        /// Losas creadas hasta ahora (la arena solo reserva memoria al crear una).
+        std::size_t losas() const;
+
+        /// Bytes del total de losas creadas.
+        std::size_t bytes() const;
+
+    private:
+        /// Una losa libre con lugar para @p bytes, o una nueva si no hay.
+        Losa* tomar(std::size_t bytes);
+
+        /// Devuelve @p losa, sin líneas pendientes, a la lista libre.
+        void reciclar(Losa* losa) noexcept;
+
+        const std::size_t bytes_por_losa_;
+        mutable std::mutex mutex_;
+        std::vector<std::unique_ptr<Losa>> todas_;
+        std::vector<Losa*> libres_;
+    };
+}
+
+#endif /* ARENA_H */
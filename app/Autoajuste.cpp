@@ -0,0 +1,78 @@
+#include "Autoajuste.h"
+
+#include <algorithm>
+
+#include "Opciones.h"
+
+namespace {
+
+    /// Menor marca alta: un lote que se consume y otro que espera.
+    constexpr std::size_t MARCA_ALTA_MINIMA = 2u;
+
+    /// Rango del tamaño de lote: hasta 16 veces menor o mayor que el inicial, sin bajar de 64 líneas por elección propia.
+    constexpr std::size_t FACTOR_LOTE = 16u;
+    constexpr std::size_t LOTE_MINIMO = 64u;
+}
+
+edad::Autoajuste::Autoajuste(const AjusteCola& inicial, std::size_t lotes, std::size_t consumidores)
+: ajuste_(inicial),
+lote_minimo_(std::min(inicial.lineas_por_lote, std::max(inicial.lineas_por_lote / FACTOR_LOTE, LOTE_MINIMO))),
+lote_maximo_(std::max(inicial.lineas_por_lote, std::min(inicial.lineas_por_lote * FACTOR_LOTE, MAX_LINEAS_POR_LOTE))),
+lotes_(std::max(lotes, MARCA_ALTA_MINIMA)),
+consumidores_(std::max<std::size_t>(consumidores, 1u)) {
+    ajuste_.marca_alta = std::clamp(ajuste_.marca_alta, MARCA_ALTA_MINIMA, lotes_);
+    ajuste_.marca_baja = std::min(ajuste_.marca_baja, ajuste_.marca_alta - 1u);
+}
+
+bool edad::Autoajuste::observar(const MuestraCola& muestra) {
+    if (convergido()) {
+        return false;
+    }
+    ++periodos_;
+    const bool reintentos = muestra.reintentos > 0u;
+    // En promedio, cada consumidor se quedó sin lotes al menos una vez en el período.
+    const bool hambre = muestra.vaciamientos >= consumidores_;
+
+    const AjusteCola anterior = ajuste_;
+    if (hambre && !reintentos) {
+        ajuste_.lineas_por_lote = std::min(ajuste_.lineas_por_lote * 2u, lote_maximo_);
+    } else if (reintentos && !hambre) {
+        if (muestra.ocupacion >= static_cast<double> (ajuste_.marca_baja)) {
+            ajuste_.marca_alta = std::max(ajuste_.marca_alta * 3u / 4u, MARCA_ALTA_MINIMA);
+            ajuste_.marca_baja = ajuste_.marca_alta / 2u;
+        }
+    } else if (reintentos && hambre) {
+        ajuste_.lineas_por_lote = std::max(ajuste_.lineas_por_lote / 2u, lote_minimo_);
+    }
+
+    const bool cambio = ajuste_.lineas_por_lote != anterior.lineas_por_lote || ajuste_.marca_alta != anterior.marca_alta;
+    if (cambio) {
+        ++ajustes_;
+        estables_ = 0u;
+    } else {
+        ++estables_;
+    }
+    if (convergido()) {
+        periodo_convergencia_ = periodos_;
+    }
+    return cambio;
+}
+
+const edad::AjusteCola& edad::Autoajuste::ajuste() const noexcept {
+    return ajuste_;
+}
+
+bool edad::Autoajuste::convergido() const noexcept {
+    return estables_ >= PERIODOS_ESTABLES || ajustes_ >= MAX_AJUSTES;
+}
+
+void edad::Autoajuste::imprimir(std::ostream& salida) const {
+    salida << "Autoajuste: --lote=" << ajuste_.lineas_por_lote << " --marca-alta=" << ajuste_.marca_alta
+            << " --marca-baja=" << ajuste_.marca_baja << " (" << ajustes_ << " cambios en " << periodos_ << " períodos de "
+            << PERIODO_AUTOAJUSTE.count() << " ms; ";
+    if (convergido()) {
+        salida << "convergió en el período " << periodo_convergencia_ << ")\n";
+    } else {
+        salida << "sin converger)\n";
+    }
+}
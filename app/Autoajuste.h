@@ -0,0 +1,115 @@
+#ifndef AUTOAJUSTE_H
+#define AUTOAJUSTE_H
+
+/**
+ * @file Autoajuste.h
+ * @brief Controlador que ajusta durante la ejecución el tamaño de lote y las marcas de agua del motor `cola`.
+ *
+ * @details
+ * El mejor `--lote` y la mejor cantidad de lotes en vuelo cambian entre una laptop, un equipo de 64 núcleos y un
+ * contenedor limitado por cgroups. Con `--autoajuste`, un lector muestrea cada `PERIODO_AUTOAJUSTE`:
+ * - **Ocupación**: lotes llenos esperando en la cola (promedio de lo visto al publicar cada lote).
+ * - **Reintentos**: veces que un lector no pudo tomar un lote libre de inmediato (cola en la marca alta o sin
+ *   lotes libres): los consumidores no alcanzan.
+ * - **Vaciamientos**: veces que un consumidor se quedó sin lotes: los lectores no alcanzan.
+ *
+ * y @ref Autoajuste::observar decide:
+ *
+ * | Período | Diagnóstico | Ajuste |
+ * |---------|-------------|--------|
+ * | vaciamientos, sin reintentos | los lectores limitan | lote ×2: menos encolados y timbres por línea en el lector |
+ * | reintentos, sin vaciamientos, ocupación sobre la marca baja | los consumidores limitan | marca alta ×¾: menos lotes en vuelo (memoria y caché) y el lector ayuda antes |
+ * | reintentos y vaciamientos | ráfagas: lotes demasiado gruesos para repartir | lote ÷2 |
+ * | ninguno | estable | ninguno |
+ *
+ * Al bajar la marca alta, la baja pasa a ser su mitad. Tras `PERIODOS_ESTABLES` períodos seguidos sin cambios (o
+ * `MAX_AJUSTES` cambios) el controlador se da por convergido y deja de ajustar; @ref Autoajuste::imprimir
+ * informa el ajuste final como opciones de línea de comandos, para fijarlas en producción.
+ *
+ * ### Marcas de agua
+ * Cuando la cola tiene `marca alta` lotes llenos, el lector deja de llenar y consume lotes él mismo hasta que
+ * queden `marca baja` (histéresis: no alterna entre leer y consumir en cada lote).
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+namespace edad {
+
+    /// Intervalo entre muestras del controlador.
+    constexpr std::chrono::milliseconds PERIODO_AUTOAJUSTE{5};
+
+    /// Períodos seguidos sin cambios tras los que el controlador se da por convergido.
+    constexpr unsigned PERIODOS_ESTABLES = 8u;
+
+    /// Cambios tras los que el controlador se da por convergido aunque no se estabilice.
+    constexpr unsigned MAX_AJUSTES = 32u;
+
+    /**
+     * @brief Tamaño de lote y marcas de agua vigentes.
+     */
+    struct AjusteCola {
+        std::size_t lineas_por_lote = 0u; ///< Líneas de cada lote que se empieza a llenar.
+        std::size_t marca_alta = 0u; ///< Lotes llenos en la cola a partir de los que el lector deja de llenar.
+        std::size_t marca_baja = 0u; ///< Lotes llenos hasta los que el lector consume antes de volver a llenar.
+    };
+
+    /**
+     * @brief Contadores de un hilo del pipeline que lee el controlador, en su propia línea de caché.
+     */
+    struct alignas(64) SondeoCola {
+        std::atomic<std::uint64_t> reintentos{0u}; ///< Veces que el lector no obtuvo un lote libre de inmediato.
+        std::atomic<std::uint64_t> vaciamientos{0u}; ///< Veces que el consumidor se quedó sin lotes.
+    };
+
+    /**
+     * @brief Lo observado en un período.
+     */
+    struct MuestraCola {
+        double ocupacion = 0.0; ///< Lotes llenos en la cola, en promedio.
+        std::uint64_t reintentos = 0u;
+        std::uint64_t vaciamientos = 0u;
+    };
+
+    /**
+     * @brief Regla de ajuste del tamaño de lote y las marcas de agua. No es thread-safe: la usa un solo lector.
+     */
+    class Autoajuste {
+    public:
+        /**
+         * @param inicial Ajuste de partida (de `--lote`, `--marca-alta` y `--marca-baja`); la marca alta se acota a
+         *        [2, @p lotes] y la baja queda por debajo de ella.
+         * @param lotes Lotes del pipeline (tope de la marca alta).
+         * @param consumidores Hilos que consumen (para normalizar los vaciamientos).
+         */
+        Autoajuste(const AjusteCola& inicial, std::size_t lotes, std::size_t consumidores);
+
+        /// Aplica la regla a la muestra de un período; retorna `true` si cambió el ajuste.
+        bool observar(const MuestraCola& muestra);
+
+        /// Ajuste vigente.
+        const AjusteCola& ajuste() const noexcept;
+
+        /// `true` si el controlador dejó de ajustar.
+        bool convergido() const noexcept;
+
+        /// Informa en @p salida el ajuste final como opciones de línea de comandos, con los cambios y períodos.
+        void imprimir(std::ostream& salida) const;
+
+    private:
+        AjusteCola ajuste_;
+        std::size_t lote_minimo_;
+        std::size_t lote_maximo_;
+        std::size_t lotes_;
+        std::size_t consumidores_;
+        unsigned periodos_ = 0u;
+        unsigned estables_ = 0u;
+        unsigned ajustes_ = 0u;
+        unsigned periodo_convergencia_ = 0u;
+    };
+}
+
+#endif /* AUTOAJUSTE_H */
@@ -0,0 +1,310 @@
+#include "Cola.h"
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include <boost/lockfree/queue.hpp>
+
+namespace {
+
+    /// Tamaño de línea de caché supuesto para separar índices escritos por hilos distintos.
+    constexpr std::size_t LINEA_CACHE = 64u;
+
+    /// Menor potencia de 2 mayor o igual que @p n (al menos 2).
+    std::size_t potencia_de_2(std::size_t n) noexcept {
+        std::size_t potencia = 2u;
+        while (potencia < n) {
+            potencia <<= 1u;
+        }
+        return potencia;
+    }
+
+    /// Adaptador de `boost::lockfree::queue` (la cola histórica del pipeline).
+    class ColaBoost final : public edad::Cola {
+    public:
+        explicit ColaBoost(std::size_t capacidad) : cola_(capacidad) {
+        }
+
+        // 'bounded_push' solo usa los nodos reservados al crearla: llena, rechaza en lugar de reservar otro nodo.
+        bool encolar(void* elemento, std::size_t) noexcept override {
+            return cola_.bounded_push(elemento);
+        }
+
+        bool desencolar(void*& elemento, std::size_t) noexcept override {
+            return cola_.pop(elemento);
+        }
+
+        bool vacia() const noexcept override {
+            return cola_.empty();
+        }
+
+    private:
+        boost::lockfree::queue<void*> cola_;
+    };
+
+    /**
+     * @brief Cola MPMC acotada de D. Vyukov: arreglo circular donde cada celda lleva un número de secuencia.
+     *
+     * @details La celda de la posición `p` está libre para encolar si su secuencia vale `p`, y lista para
+     *          desencolar si vale `p + 1`. Cada operación reclama su posición con un CAS sobre el índice
+     *          correspondiente y publica con un store-release sobre la secuencia de la celda.
+     */
+    class ColaVyukov final : public edad::Cola {
+    public:
+        explicit ColaVyukov(std::size_t capacidad)
+        : mascara_(potencia_de_2(capacidad) - 1u), celdas_(new Celda[mascara_ + 1u]) {
+            for (std::size_t i = 0u; i <= mascara_; ++i) {
+                celdas_[i].secuencia.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        bool encolar(void* elemento, std::size_t) noexcept override {
+            std::size_t posicion = escritura_.load(std::memory_order_relaxed);
+            Celda* celda;
+            for (;;) {
+                celda = &celdas_[posicion & mascara_];
+                const std::size_t secuencia = celda->secuencia.load(std::memory_order_acquire);
+                const std::intptr_t diferencia = static_cast<std::intptr_t> (secuencia) - static_cast<std::intptr_t> (posicion);
+                if (diferencia == 0) {
+                    if (escritura_.compare_exchange_weak(posicion, posicion + 1u, std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (diferencia < 0) {
+                    return false; // llena: la celda aún no fue desencolada en la vuelta anterior
+                } else {
+                    posicion = escritura_.load(std::memory_order_relaxed);
+                }
+            }
+            celda->dato = elemento;
+            celda->secuencia.store(posicion + 1u, std::memory_order_release);
+            return true;
+        }
+
+        bool desencolar(void*& elemento, std::size_t) noexcept override {
+            std::size_t posicion = lectura_.load(std::memory_order_relaxed);
+            Celda* celda;
+            for (;;) {
+                celda = &celdas_[posicion & mascara_];
+                const std::size_t secuencia = celda->secuencia.load(std::memory_order_acquire);
+                const std::intptr_t diferencia = static_cast<std::intptr_t> (secuencia) - static_cast<std::intptr_t> (posicion + 1u);
+                if (diferencia == 0) {
+                    if (lectura_.compare_exchange_weak(posicion, posicion + 1u, std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (diferencia < 0) {
+                    return false; // vacía
+                } else {
+                    posicion = lectura_.load(std::memory_order_relaxed);
+                }
+            }
+            elemento = celda->dato;
+            celda->secuencia.store(posicion + mascara_ + 1u, std::memory_order_release);
+            return true;
+        }
+
+        bool vacia() const noexcept override {
+            return lectura_.load(std::memory_order_acquire) >= escritura_.load(std::memory_order_acquire);
+        }
+
+    private:
+        struct Celda {
+            std::atomic<std::size_t> secuencia;
+            void* dato;
+        };
+
+        const std::size_t mascara_;
+        std::unique_ptr<Celda[]> celdas_;
+        alignas(LINEA_CACHE) std::atomic<std::size_t> escritura_{0u};
+        alignas(LINEA_CACHE) std::atomic<std::size_t> lectura_{0u};
+    };
+
+    /**
+     * @brief Anillo de un productor; un consumidor (@ref sacar) o varios (@ref sacar_compartido, con CAS).
+     */
+    class Anillo {
+    public:
+        explicit Anillo(std::size_t capacidad)
+        : mascara_(potencia_de_2(capacidad) - 1u), ranuras_(new std::atomic<void*>[mascara_ + 1u]) {
+        }
+
+        bool poner(void* elemento) noexcept {
+            const std::size_t escritura = escritura_.load(std::memory_order_relaxed);
+            if (escritura - lectura_.load(std::memory_order_acquire) > mascara_) {
+                return false;
+            }
+            ranuras_[escritura & mascara_].store(elemento, std::memory_order_relaxed);
+            escritura_.store(escritura + 1u, std::memory_order_release);
+            return true;
+        }
+
+        /// Extracción del único consumidor del anillo.
+        bool sacar(void*& elemento) noexcept {
+            const std::size_t lectura = lectura_.load(std::memory_order_relaxed);
+            if (lectura == escritura_.load(std::memory_order_acquire)) {
+                return false;
+            }
+            elemento = ranuras_[lectura & mascara_].load(std::memory_order_relaxed);
+            lectura_.store(lectura + 1u, std::memory_order_release);
+            return true;
+        }
+
+        /// Extracción con varios consumidores: el CAS sobre el índice de lectura decide quién se queda el elemento.
+        bool sacar_compartido(void*& elemento) noexcept {
+            std::size_t lectura = lectura_.load(std::memory_order_acquire);
+            for (;;) {
+                if (lectura == escritura_.load(std::memory_order_acquire)) {
+                    return false;
+                }
+                // Si el CAS tiene éxito, la ranura no pudo reutilizarse: el productor espera a que avance la lectura.
+                elemento = ranuras_[lectura & mascara_].load(std::memory_order_relaxed);
+                if (lectura_.compare_exchange_weak(lectura, lectura + 1u, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                    return true;
+                }
+            }
+        }
+
+        bool vacio() const noexcept {
+            return lectura_.load(std::memory_order_acquire) == escritura_.load(std::memory_order_acquire);
+        }
+
+    private:
+        const std::size_t mascara_;
+        std::unique_ptr<std::atomic<void*>[]> ranuras_;
+        alignas(LINEA_CACHE) std::atomic<std::size_t> escritura_{0u};
+        alignas(LINEA_CACHE) std::atomic<std::size_t> lectura_{0u};
+    };
+
+    /**
+     * @brief Un @ref Anillo por par (productor, consumidor); cada productor reparte round-robin entre sus anillos.
+     *
+     * @details Un anillo lleno se salta (el elemento va al siguiente consumidor), así que un consumidor lento no
+     *          detiene al productor mientras otro tenga espacio. Con @p robo, un consumidor cuyos anillos están
+     *          vacíos extrae de los de los demás; entonces todas las extracciones usan CAS.
+     */
+    class ColaAnillos final : public edad::Cola {
+    public:
+        ColaAnillos(std::size_t capacidad, std::size_t productores, std::size_t consumidores, bool robo)
+        : productores_(productores), consumidores_(consumidores), robo_(robo), cursores_(productores) {
+            const std::size_t por_anillo = (capacidad + productores * consumidores - 1u) / (productores * consumidores);
+            anillos_.reserve(productores * consumidores);
+            for (std::size_t i = 0u; i < productores * consumidores; ++i) {
+                anillos_.emplace_back(new Anillo(por_anillo));
+            }
+        }
+
+        bool encolar(void* elemento, std::size_t productor) noexcept override {
+            std::size_t& cursor = cursores_[productor].siguiente;
+            for (std::size_t k = 0u; k < consumidores_; ++k) {
+                const std::size_t consumidor = (cursor + k) % consumidores_;
+                if (anillo(productor, consumidor).poner(elemento)) {
+                    cursor = consumidor + 1u;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool desencolar(void*& elemento, std::size_t consumidor) noexcept override {
+            for (std::size_t productor = 0u; productor < productores_; ++productor) {
+                Anillo& propio = anillo(productor, consumidor);
+                if (robo_ ? propio.sacar_compartido(elemento) : propio.sacar(elemento)) {
+                    return true;
+                }
+            }
+            if (robo_) {
+                for (std::size_t k = 1u; k < consumidores_; ++k) {
+                    const std::size_t victima = (consumidor + k) % consumidores_;
+                    for (std::size_t productor = 0u; productor < productores_; ++productor) {
+                        if (anillo(productor, victima).sacar_compartido(elemento)) {
+                            return true;
+                        }
+                    }
+                }
+            }
+            return false;
+        }
+
+        bool vacia() const noexcept override {
+            for (const std::unique_ptr<Anillo>& anillo : anillos_) {
+                if (!anillo->vacio()) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+    private:
+        /// Cursor round-robin de un productor, en su propia línea de caché.
+        struct alignas(LINEA_CACHE) Cursor {
+            std::size_t siguiente = 0u;
+        };
+
+        Anillo& anillo(std::size_t productor, std::size_t consumidor) noexcept {
+            return *anillos_[productor * consumidores_ + consumidor];
+        }
+
+        const std::size_t productores_;
+        const std::size_t consumidores_;
+        const bool robo_;
+        std::vector<Cursor> cursores_;
+        std::vector<std::unique_ptr<Anillo>> anillos_;
+    };
+}
+
+namespace {
+
+    /// Todas las colas, en el orden en que se listan en los mensajes.
+    constexpr edad::TipoCola TIPOS_COLA[] = {edad::TipoCola::boost, edad::TipoCola::vyukov, edad::TipoCola::anillos,
+        edad::TipoCola::anillos_robo};
+}
+
+const char* edad::nombre_cola(TipoCola tipo) noexcept {
+    switch (tipo) {
+        case TipoCola::boost:
+            return "boost";
+        case TipoCola::vyukov:
+            return "vyukov";
+        case TipoCola::anillos:
+            return "anillos";
+        case TipoCola::anillos_robo:
+            return "anillos-robo";
+    }
+    return "?";
+}
+
+bool edad::parsear_tipo_cola(const std::string& texto, TipoCola& tipo) noexcept {
+    for (const TipoCola candidato : TIPOS_COLA) {
+        if (texto == nombre_cola(candidato)) {
+            tipo = candidato;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string edad::nombres_colas() {
+    std::string nombres;
+    const std::size_t cantidad = sizeof (TIPOS_COLA) / sizeof (TIPOS_COLA[0]);
+    for (std::size_t i = 0u; i < cantidad; ++i) {
+        nombres += i == 0u ? "" : (i + 1u == cantidad ? " o " : ", ");
+        nombres += nombre_cola(TIPOS_COLA[i]);
+    }
+    return nombres;
+}
+
+std::unique_ptr<edad::Cola> edad::crear_cola(TipoCola tipo, std::size_t capacidad, std::size_t productores, std::size_t consumidores) {
+    productores = productores == 0u ? 1u : productores;
+    consumidores = consumidores == 0u ? 1u : consumidores;
+    switch (tipo) {
+        case TipoCola::vyukov:
+            return std::make_unique<ColaVyukov>(capacidad);
+        case TipoCola::anillos:
+            return std::make_unique<ColaAnillos>(capacidad, productores, consumidores, false);
+        case TipoCola::anillos_robo:
+            return std::make_unique<ColaAnillos>(capacidad, productores, consumidores, true);
+        case TipoCola::boost:
+            break;
+    }
+    return std::make_unique<ColaBoost>(capacidad);
+}
@@ -0,0 +1,119 @@
+#ifndef COLA_H
+#define COLA_H
+
+/**
+ * @file Cola.h
+ * @brief Colas intercambiables para el pipeline productor–consumidor del motor `cola` (y para `bench_colas`).
+ *
+ * @details
+ * Todas transportan punteros (`void*`, con la envoltura tipada @ref ColaDe) y exponen la misma interfaz
+ * no bloqueante: @ref Cola::encolar retorna `false` si la cola está llena y @ref Cola::desencolar si no
+ * hay elementos para ese consumidor; la espera (yield, etc.) queda a cargo de quien llama.
+ *
+ * | Tipo | Estructura | Capacidad | Notas |
+ * |------|------------|-----------|-------|
+ * | `boost` | `boost::lockfree::queue` (lista enlazada con *freelist*, MPMC) | fija (nodos reservados al crearla) | histórico; dos CAS por operación |
+ * | `vyukov` | arreglo circular MPMC con número de secuencia por celda (D. Vyukov) | fija (potencia de 2) | un CAS por operación, sin nodos |
+ * | `anillos` | un anillo SPSC por par (productor, consumidor), reparto round-robin | fija, dividida entre anillos | sin CAS: solo cargas/almacenamientos acquire/release |
+ * | `anillos-robo` | como `anillos`, pero un consumidor sin trabajo roba de los anillos de otros | ídem | un CAS por extracción para admitir ladrones |
+ *
+ * Con un solo productor y muchos consumidores, una cola MPMC hace que todos compitan por el mismo índice
+ * de lectura; los anillos por consumidor eliminan esa contención a costa de balanceo (round-robin ciego
+ * al ritmo de cada consumidor) o de un CAS por extracción (robo). `bench_colas` mide ambos casos.
+ *
+ * ### Identificadores
+ * `productor` debe ser menor que la cantidad de productores y `consumidor` menor que la de consumidores
+ * indicadas a @ref crear_cola; solo los anillos los usan. En los anillos, cada productor debe encolar
+ * desde un único hilo a la vez, y (sin robo) cada consumidor desencolar desde un único hilo a la vez.
+ * Sin robo, los anillos de un consumidor solo los vacía él: la cantidad indicada debe ser la de consumidores que
+ * realmente desencolan (p. ej. la del equipo OpenMP obtenido, no la pedida), o la cola se llenará sin vaciarse.
+ */
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace edad {
+
+    /**
+     * @brief Implementación de cola (ver tabla en Cola.h).
+     */
+    enum class TipoCola {
+        boost, ///< `boost::lockfree::queue` MPMC.
+        vyukov, ///< Arreglo acotado MPMC de Vyukov.
+        anillos, ///< Anillos SPSC por consumidor, reparto round-robin.
+        anillos_robo ///< Anillos por consumidor con robo de trabajo.
+    };
+
+    /// Nombre de @p tipo tal como se escribe en la línea de comandos (`boost`, `vyukov`, `anillos`, `anillos-robo`).
+    const char* nombre_cola(TipoCola tipo) noexcept;
+
+    /// Interpreta @p texto como nombre de cola; retorna `false` si no corresponde a ninguno.
+    bool parsear_tipo_cola(const std::string& texto, TipoCola& tipo) noexcept;
+
+    /// Nombres aceptados por @ref parsear_tipo_cola, para mensajes de error ("boost, vyukov, anillos o anillos-robo").
+    std::string nombres_colas();
+
+    /**
+     * @brief Interfaz común de las colas de punteros. Thread-safe según lo indicado en Cola.h.
+     */
+    class Cola {
+    public:
+        virtual ~Cola() = default;
+
+        /// Agrega @p elemento; retorna `false` si la cola (o todos los anillos de @p productor) está llena.
+        virtual bool encolar(void* elemento, std::size_t productor) noexcept = 0;
+
+        /// Extrae un elemento para @p consumidor; retorna `false` si no hay.
+        virtual bool desencolar(void*& elemento, std::size_t consumidor) noexcept = 0;
+
+        /**
+         * @brief Indica si no queda ningún elemento en la cola.
+         * @details Exacta solo cuando no hay encolados concurrentes (p. ej. tras el fin del productor).
+         */
+        virtual bool vacia() const noexcept = 0;
+    };
+
+    /**
+     * @brief Crea una cola del tipo indicado.
+     *
+     * @param tipo Implementación.
+     * @param capacidad Elementos que admite (total; en los anillos se reparte entre ellos). Se redondea hacia
+     *        arriba a potencia de 2 en las colas acotadas.
+     * @param productores Cantidad de productores (al menos 1).
+     * @param consumidores Cantidad de consumidores (al menos 1).
+     */
+    std::unique_ptr<Cola> crear_cola(TipoCola tipo, std::size_t capacidad, std::size_t productores, std::size_t consumidores);
+
+    /**
+     * @brief Envoltura tipada de @ref Cola para punteros a @p T.
+     */
+    template <typename T>
+    class ColaDe {
+    public:
+        explicit ColaDe(std::unique_ptr<Cola> cola) : cola_(std::move(cola)) {
+        }
+
+        bool encolar(T* elemento, std::size_t productor = 0u) noexcept {
+            return cola_->encolar(elemento, productor);
+        }
+
+        bool desencolar(T*& elemento, std::size_t consumidor) noexcept {
+            void* dato = nullptr;
+            if (!cola_->desencolar(dato, consumidor)) {
+                return false;
+            }
+            elemento = static_cast<T*> (dato);
+            return true;
+        }
+
+        bool vacia() const noexcept {
+            return cola_->vacia();
+        }
+
+    private:
+        std::unique_ptr<Cola> cola_;
+    };
+}
+
+#endif /* COLA_H */
@@ -0,0 +1,90 @@
+#include "Corrutinas.h"
+
+#include <exception>
+
+void edad::Tarea::promise_type::Final::await_suspend(std::coroutine_handle<promise_type> corrutina) noexcept {
+    Planificador* planificador = corrutina.promise().planificador;
+    corrutina.destroy();
+    planificador->terminada();
+}
+
+void edad::Tarea::promise_type::unhandled_exception() noexcept {
+    // Una etapa a medias dejaría a las demás suspendidas para siempre: mismo criterio que un std::thread.
+    std::terminate();
+}
+
+edad::Tarea::~Tarea() {
+    if (corrutina_) {
+        corrutina_.destroy();
+    }
+}
+
+edad::Planificador::Planificador(std::size_t hilos) {
+    hilos_.reserve(hilos > 0u ? hilos : 1u);
+    for (std::size_t i = 0u; i < (hilos > 0u ? hilos : 1u); ++i) {
+        hilos_.emplace_back([this]() {
+            trabajar();
+        });
+    }
+}
+
+edad::Planificador::~Planificador() {
+    {
+        std::lock_guard<std::mutex> cerrojo(mutex_);
+        cerrando_ = true;
+    }
+    hay_listas_.notify_all();
+    for (std::thread& hilo : hilos_) {
+        hilo.join();
+    }
+}
+
+void edad::Planificador::lanzar(Tarea tarea) {
+    const std::coroutine_handle<Tarea::promise_type> corrutina = std::exchange(tarea.corrutina_, nullptr);
+    corrutina.promise().planificador = this;
+    {
+        std::lock_guard<std::mutex> cerrojo(mutex_);
+        ++vivas_;
+    }
+    programar(corrutina);
+}
+
+void edad::Planificador::esperar() {
+    std::unique_lock<std::mutex> cerrojo(mutex_);
+    sin_tareas_.wait(cerrojo, [this]() {
+        return vivas_ == 0u;
+    });
+}
+
+void edad::Planificador::programar(std::coroutine_handle<> corrutina) {
+    {
+        std::lock_guard<std::mutex> cerrojo(mutex_);
+        listas_.push_back(corrutina);
+    }
+    hay_listas_.notify_one();
+}
+
+void edad::Planificador::terminada() noexcept {
+    std::lock_guard<std::mutex> cerrojo(mutex_);
+    if (--vivas_ == 0u) {
+        sin_tareas_.notify_all();
+    }
+}
+
+void edad::Planificador::trabajar() {
+    for (;;) {
+        std::coroutine_handle<> corrutina;
+        {
+            std::unique_lock<std::mutex> cerrojo(mutex_);
+            hay_listas_.wait(cerrojo, [this]() {
+                return cerrando_ || !listas_.empty();
+            });
+            if (listas_.empty()) {
+                return;
+            }
+            corrutina = listas_.front();
+            listas_.pop_front();
+        }
+        corrutina.resume();
+    }
+}
@@ -0,0 +1,290 @@
+#ifndef CORRUTINAS_H
+#define CORRUTINAS_H
+
+/**
+ * @file Corrutinas.h
+ * @brief Piezas para pipelines de corrutinas de C++20: un grupo de hilos, tareas y canales acotados.
+ *
+ * @details
+ * Cada etapa de un pipeline es una corrutina que devuelve @ref Tarea y se comunica con las demás por
+ * @ref Canal. Un canal lleno o vacío **suspende** la corrutina (su marco queda en la lista de espera del canal y
+ * el hilo pasa a otra corrutina lista); quien libera espacio o publica un elemento la reprograma en el
+ * @ref Planificador. Ningún hilo gira ni duerme esperando a otra etapa: los hilos del grupo solo duermen si no
+ * hay ninguna corrutina lista.
+ *
+ * @code{.cpp}
+ * edad::Tarea producir(edad::Canal<int>& canal) {
+ *     for (int i = 0; i < 100; ++i) {
+ *         co_await canal.enviar(i);   // se suspende si el canal está lleno
+ *     }
+ *     canal.cerrar();
+ * }
+ *
+ * edad::Tarea sumar(edad::Canal<int>& canal, long& total) {
+ *     while (std::optional<int> valor = co_await canal.recibir()) {   // nullopt: cerrado y vacío
+ *         total += *valor;
+ *     }
+ * }
+ *
+ * edad::Planificador planificador(4u);
+ * edad::Canal<int> canal(planificador, 8u);
+ * long total = 0;
+ * planificador.lanzar(producir(canal));
+ * planificador.lanzar(sumar(canal, total));
+ * planificador.esperar();
+ * @endcode
+ *
+ * Agregar una etapa (filtrar, descomprimir, validar) es escribir otra corrutina entre dos canales, sin tocar
+ * las existentes. Los parámetros por referencia de una corrutina deben sobrevivir a @ref Planificador::esperar.
+ */
+
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace edad {
+
+    class Planificador;
+
+    /**
+     * @brief Corrutina lanzada en un @ref Planificador (sin valor de retorno).
+     *
+     * @details Empieza suspendida; @ref Planificador::lanzar la programa y su marco se destruye solo al
+     *          terminar. Una excepción que escape de la corrutina termina el programa (como en un `std::thread`).
+     */
+    class Tarea {
+    public:
+        struct promise_type {
+            Planificador* planificador = nullptr;
+
+            Tarea get_return_object() noexcept {
+                return Tarea(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+
+            std::suspend_always initial_suspend() noexcept {
+                return {};
+            }
+
+            /// Suspensión final: avisa al planificador y destruye el marco.
+            struct Final {
+                bool await_ready() noexcept {
+                    return false;
+                }
+
+                void await_suspend(std::coroutine_handle<promise_type> corrutina) noexcept;
+
+                void await_resume() noexcept {
+                }
+            };
+
+            Final final_suspend() noexcept {
+                return {};
+            }
+
+            void return_void() noexcept {
+            }
+
+            void unhandled_exception() noexcept;
+        };
+
+        Tarea(Tarea&& otra) noexcept : corrutina_(std::exchange(otra.corrutina_, nullptr)) {
+        }
+
+        Tarea(const Tarea&) = delete;
+        Tarea& operator=(const Tarea&) = delete;
+        Tarea& operator=(Tarea&&) = delete;
+
+        /// Destruye la corrutina si nunca se lanzó.
+        ~Tarea();
+
+    private:
+        friend class Planificador;
+
+        explicit Tarea(std::coroutine_handle<promise_type> corrutina) noexcept : corrutina_(corrutina) {
+        }
+
+        std::coroutine_handle<promise_type> corrutina_;
+    };
+
+    /**
+     * @brief Grupo fijo de hilos que reanudan corrutinas listas, en orden de llegada. Thread-safe.
+     */
+    class Planificador {
+    public:
+        /// Crea @p hilos hilos (al menos uno), dormidos hasta que haya corrutinas listas.
+        explicit Planificador(std::size_t hilos);
+
+        /// Termina los hilos; quien lo destruye debe haber esperado las tareas (@ref esperar).
+        ~Planificador();
+
+        Planificador(const Planificador&) = delete;
+        Planificador& operator=(const Planificador&) = delete;
+
+        /// Programa @p tarea; corre en algún hilo del grupo.
+        void lanzar(Tarea tarea);
+
+        /// Bloquea a quien llama (que no debe ser un hilo del grupo) hasta que terminen todas las tareas lanzadas.
+        void esperar();
+
+        /// Encola @p corrutina para que algún hilo del grupo la reanude.
+        void programar(std::coroutine_handle<> corrutina);
+
+    private:
+        friend struct Tarea::promise_type;
+
+        /// Registra el fin de una tarea.
+        void terminada() noexcept;
+
+        /// Bucle de cada hilo: tomar una corrutina lista y reanudarla.
+        void trabajar();
+
+        std::mutex mutex_;
+        std::condition_variable hay_listas_;
+        std::condition_variable sin_tareas_;
+        std::deque<std::coroutine_handle<>> listas_;
+        std::size_t vivas_ = 0u;
+        bool cerrando_ = false;
+        std::vector<std::thread> hilos_;
+    };
+
+    /**
+     * @brief Canal acotado entre corrutinas de un mismo @ref Planificador. Thread-safe.
+     *
+     * @details Con capacidad `C`, a lo sumo `C` elementos esperan en el canal; un emisor más se suspende hasta
+     *          que un receptor tome uno (contrapresión). Un receptor sin elementos se suspende hasta que llegue
+     *          uno o el canal se cierre. El canal se cierra cuando cada uno de sus `productores` llamó a
+     *          @ref cerrar; los receptores reciben lo pendiente y luego `std::nullopt`.
+     */
+    template <typename T>
+    class Canal {
+    public:
+        /// @p capacidad y @p productores son al menos 1.
+        Canal(Planificador& planificador, std::size_t capacidad, std::size_t productores = 1u)
+        : planificador_(planificador), capacidad_(capacidad > 0u ? capacidad : 1u), productores_(productores > 0u ? productores : 1u) {
+        }
+
+        Canal(const Canal&) = delete;
+        Canal& operator=(const Canal&) = delete;
+
+        /// `co_await canal.enviar(valor)`: entrega @p valor, suspendiéndose mientras el canal esté lleno.
+        auto enviar(T valor) {
+            struct Envio {
+                Canal& canal;
+                T valor;
+
+                bool await_ready() noexcept {
+                    return false;
+                }
+
+                bool await_suspend(std::coroutine_handle<> corrutina) {
+                    return canal.suspender_envio(valor, corrutina);
+                }
+
+                void await_resume() noexcept {
+                }
+            };
+            return Envio{*this, std::move(valor)};
+        }
+
+        /// `co_await canal.recibir()`: el siguiente elemento, o `std::nullopt` si el canal se cerró y está vacío.
+        auto recibir() {
+            struct Recepcion {
+                Canal& canal;
+                std::optional<T> valor;
+
+                bool await_ready() noexcept {
+                    return false;
+                }
+
+                bool await_suspend(std::coroutine_handle<> corrutina) {
+                    return canal.suspender_recepcion(valor, corrutina);
+                }
+
+                std::optional<T> await_resume() {
+                    return std::move(valor);
+                }
+            };
+            return Recepcion{*this, std::nullopt};
+        }
+
+        /// Un productor terminó; al terminar todos, se despierta a los receptores en espera.
+        void cerrar() {
+            std::lock_guard<std::mutex> cerrojo(mutex_);
+            if (productores_ > 0u && --productores_ == 0u) {
+                for (const Receptor& receptor : receptores_) {
+                    planificador_.programar(receptor.corrutina);
+                }
+                receptores_.clear();
+            }
+        }
+
+    private:
+        struct Emisor {
+            std::coroutine_handle<> corrutina;
+            T* valor;
+        };
+
+        struct Receptor {
+            std::coroutine_handle<> corrutina;
+            std::optional<T>* destino;
+        };
+
+        /// Entrega @p valor si hay lugar (retorna `false`: no suspender) o deja a @p corrutina en espera.
+        bool suspender_envio(T& valor, std::coroutine_handle<> corrutina) {
+            std::lock_guard<std::mutex> cerrojo(mutex_);
+            if (!receptores_.empty()) {
+                // Hay receptores esperando, así que el búfer está vacío: el valor pasa directo.
+                const Receptor receptor = receptores_.front();
+                receptores_.pop_front();
+                receptor.destino->emplace(std::move(valor));
+                planificador_.programar(receptor.corrutina);
+                return false;
+            }
+            if (elementos_.size() < capacidad_) {
+                elementos_.push_back(std::move(valor));
+                return false;
+            }
+            // Tras soltar el cerrojo, otro hilo puede reanudarla en cualquier momento: no tocar el marco después.
+            emisores_.push_back(Emisor{corrutina, &valor});
+            return true;
+        }
+
+        /// Toma un elemento si hay (retorna `false`: no suspender) o deja a @p corrutina en espera.
+        bool suspender_recepcion(std::optional<T>& destino, std::coroutine_handle<> corrutina) {
+            std::lock_guard<std::mutex> cerrojo(mutex_);
+            if (!elementos_.empty()) {
+                destino.emplace(std::move(elementos_.front()));
+                elementos_.pop_front();
+                if (!emisores_.empty()) {
+                    // Se liberó un lugar: entra el valor del emisor más antiguo y este sigue.
+                    const Emisor emisor = emisores_.front();
+                    emisores_.pop_front();
+                    elementos_.push_back(std::move(*emisor.valor));
+                    planificador_.programar(emisor.corrutina);
+                }
+                return false;
+            }
+            if (productores_ == 0u) {
+                return false;
+            }
+            receptores_.push_back(Receptor{corrutina, &destino});
+            return true;
+        }
+
+        Planificador& planificador_;
+        const std::size_t capacidad_;
+        std::mutex mutex_;
+        std::size_t productores_;
+        std::deque<T> elementos_;
+        std::deque<Emisor> emisores_;
+        std::deque<Receptor> receptores_;
+    };
+}
+
+#endif /* CORRUTINAS_H */
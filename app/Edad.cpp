@@ -1,5 +1,14 @@
 #include "Edad.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <limits>
+#include <stdexcept>
+
+#include "FechaSimd.h"
+
 long long edad::fecha_a_dias( long long anio, unsigned int mes, unsigned int dia) noexcept {
     anio -= mes <= 2;
     const long long era = (anio >= 0 ? anio : anio - 399) / 400;
@@ -9,23 +18,98 @@ long long edad::fecha_a_dias( long long anio, unsigned int mes, unsigned int dia
     return era * 146097 + static_cast<long long> (dias_era) - 719468; // 719468 = días hasta 1970-01-01
 }
 
-std::tuple<int, int, int> edad::parsear_fecha_iso(const std::string& texto) {
-    if (texto.size() != 10 || texto[4] != '-' || texto[7] != '-') {
-        throw std::invalid_argument("Formato inválido; se espera YYYY-MM-DD");
+unsigned int edad::dias_del_mes(long long anio, unsigned int mes) noexcept {
+    if (mes == 2) {
+        const bool bisiesto = (anio % 4 == 0) && (anio % 100 != 0 || anio % 400 == 0);
+        return bisiesto ? 29u : 28u;
     }
-    int anio = std::stoi(texto.substr(0, 4));
-    int mes = std::stoi(texto.substr(5, 2));
-    int dia = std::stoi(texto.substr(8, 2));
-    return {anio, mes, dia};
+    return (mes == 4 || mes == 6 || mes == 9 || mes == 11) ? 30u : 31u;
 }
 
-double edad::calcular(const std::string& fecha_nacimiento) {
-    // Parseo de la fecha de nacimiento
-    int anio_nac, mes_nac, dia_nac;
-    std::tie(anio_nac, mes_nac, dia_nac) = edad::parsear_fecha_iso(fecha_nacimiento);
-    const long long dias_nacimiento = edad::fecha_a_dias(anio_nac, mes_nac, dia_nac);
+const char* edad::descripcion(ErrorFecha error) noexcept {
+    switch (error) {
+        case ErrorFecha::ninguno: return "fecha válida";
+        case ErrorFecha::longitud: return "longitud distinta de 10 caracteres";
+        case ErrorFecha::separador: return "separador distinto de '-'";
+        case ErrorFecha::digito: return "carácter no numérico";
+        case ErrorFecha::mes: return "mes fuera de rango";
+        case ErrorFecha::dia: return "día fuera de rango";
+    }
+    return "error desconocido";
+}
+
+edad::Fecha edad::dias_a_fecha(long long dias) noexcept {
+    dias += 719468;
+    const long long era = (dias >= 0 ? dias : dias - 146096) / 146097;
+    const unsigned dias_era = static_cast<unsigned> (dias - era * 146097);
+    const unsigned anio_era = (dias_era - dias_era / 1460 + dias_era / 36524 - dias_era / 146096) / 365;
+    const unsigned dia_anio = dias_era - (365 * anio_era + anio_era / 4 - anio_era / 100);
+    const unsigned mes_marzo = (5 * dia_anio + 2) / 153;
+    const unsigned dia = dia_anio - (153 * mes_marzo + 2) / 5 + 1;
+    const unsigned mes = mes_marzo < 10 ? mes_marzo + 3 : mes_marzo - 9;
+    const long long anio = static_cast<long long> (anio_era) + era * 400 + (mes <= 2);
+    return Fecha{static_cast<int> (anio), mes, dia};
+}
+
+edad::ResultadoFecha edad::parsear_fecha(const char* inicio, const char* fin, Fecha& fecha) noexcept {
+    if (fin - inicio < 10) {
+        return {inicio, ErrorFecha::longitud};
+    }
+    if (inicio[4] != '-' || inicio[7] != '-') {
+        return {inicio, ErrorFecha::separador};
+    }
+
+    // Posiciones de los 8 dígitos en "YYYY-MM-DD"; la resta se hace sin signo para que
+    // cualquier carácter menor que '0' también quede fuera de [0..9].
+    constexpr int POSICIONES[8] = {0, 1, 2, 3, 5, 6, 8, 9};
+    unsigned int digitos[8];
+    for (int i = 0; i < 8; ++i) {
+        digitos[i] = static_cast<unsigned char> (inicio[POSICIONES[i]]) - static_cast<unsigned> ('0');
+        if (digitos[i] > 9u) {
+            return {inicio, ErrorFecha::digito};
+        }
+    }
+
+    const int anio = static_cast<int> (digitos[0] * 1000u + digitos[1] * 100u + digitos[2] * 10u + digitos[3]);
+    const unsigned int mes = digitos[4] * 10u + digitos[5];
+    const unsigned int dia = digitos[6] * 10u + digitos[7];
+    if (mes < 1u || mes > 12u) {
+        return {inicio, ErrorFecha::mes};
+    }
+    if (dia < 1u || dia > edad::dias_del_mes(anio, mes)) {
+        return {inicio, ErrorFecha::dia};
+    }
+
+    fecha = Fecha{anio, mes, dia};
+    return {inicio + 10, ErrorFecha::ninguno};
+}
+
+edad::ErrorFecha edad::parsear_fecha(std::string_view texto, Fecha& fecha) noexcept {
+    const char* fin = texto.data() + texto.size();
+    const ResultadoFecha resultado = edad::parsear_fecha(texto.data(), fin, fecha);
+    if (resultado.error != ErrorFecha::ninguno) {
+        return resultado.error;
+    }
+    return resultado.ptr == fin ? ErrorFecha::ninguno : ErrorFecha::longitud;
+}
+
+std::tuple<int, int, int> edad::parsear_fecha_iso(std::string_view texto) {
+    Fecha fecha{};
+    const ErrorFecha error = edad::parsear_fecha(texto, fecha);
+    if (error != ErrorFecha::ninguno) {
+        throw std::invalid_argument(std::string("Formato inválido; se espera YYYY-MM-DD: ") + edad::descripcion(error));
+    }
+    return {fecha.anio, static_cast<int> (fecha.mes), static_cast<int> (fecha.dia)};
+}
 
-    // Fecha actual
+std::string edad::formatear_fecha(long long dias) {
+    const Fecha fecha = edad::dias_a_fecha(dias);
+    std::ostringstream texto;
+    texto << std::setfill('0') << std::setw(4) << fecha.anio << '-' << std::setw(2) << fecha.mes << '-' << std::setw(2) << fecha.dia;
+    return texto.str();
+}
+
+long long edad::dias_hoy() {
     std::time_t tiempo = std::time(nullptr);
     std::tm fecha_actual{};
 #ifdef _WIN32
@@ -33,13 +117,155 @@ double edad::calcular(const std::string& fecha_nacimiento) {
 #else
     localtime_r(&tiempo, &fecha_actual);
 #endif
-    const long long dias_hoy = edad::fecha_a_dias(
+    return edad::fecha_a_dias(
             static_cast<long long> (fecha_actual.tm_year + 1900),
             static_cast<unsigned> (fecha_actual.tm_mon + 1),
             static_cast<unsigned> (fecha_actual.tm_mday)
             );
+}
 
-    // Cálculo de la edad
+edad::Calculadora::Calculadora() : Calculadora(edad::dias_hoy()) {
+}
+
+edad::Calculadora::Calculadora(long long dias_referencia, ModoEdad modo)
+: dias_referencia_(dias_referencia), modo_(modo) {
+    const Fecha referencia = edad::dias_a_fecha(dias_referencia);
+    anio_referencia_ = referencia.anio;
+    mes_dia_referencia_ = static_cast<std::int32_t> (referencia.mes * 32u + referencia.dia);
+
+    // Tabla desfase -> edad: la edad no decrece con el desfase, así que basta avanzar hasta superar EDAD_MAXIMA.
+    edad_por_dia_.reserve(static_cast<std::size_t> ((EDAD_MAXIMA + 2) * 366));
+    for (long long desfase = 0;; ++desfase) {
+        const int edad = edad_por_desfase(desfase);
+        if (edad > EDAD_MAXIMA) {
+            break;
+        }
+        edad_por_dia_.push_back(static_cast<std::uint8_t> (edad));
+    }
+}
+
+edad::Calculadora::Calculadora(long long anio, unsigned int mes, unsigned int dia, ModoEdad modo)
+: Calculadora(edad::fecha_a_dias(anio, mes, dia), modo) {
+}
+
+long long edad::Calculadora::dias_referencia() const noexcept {
+    return dias_referencia_;
+}
+
+edad::ModoEdad edad::Calculadora::modo() const noexcept {
+    return modo_;
+}
+
+namespace {
+
+    /// Duración promedio del año gregoriano (incluye bisiestos).
     constexpr double DIAS_PROMEDIO_ANIO = 365.2425;
-    return static_cast<double> (dias_hoy - dias_nacimiento) / DIAS_PROMEDIO_ANIO;
-}
\ No newline at end of file
+
+    /// Días de nacimiento y validez de hasta LINEAS_POR_BLOQUE fechas (parseo y conversión SIMD).
+    std::size_t dias_bloque(const std::string_view* fechas, std::size_t n, std::int32_t* dias_nacimiento, std::uint8_t* validas) noexcept {
+        std::int32_t anios[edad::LINEAS_POR_BLOQUE];
+        std::int32_t meses[edad::LINEAS_POR_BLOQUE];
+        std::int32_t dias[edad::LINEAS_POR_BLOQUE];
+        const std::size_t invalidas = edad::parsear_fechas_lote(fechas, n, anios, meses, dias, validas);
+        edad::fechas_a_dias_lote(anios, meses, dias, n, dias_nacimiento);
+        return invalidas;
+    }
+}
+
+double edad::Calculadora::calcular(std::string_view fecha_nacimiento) const noexcept {
+    // Parseo de la fecha de nacimiento (sin excepciones ni memoria dinámica)
+    Fecha fecha;
+    if (edad::parsear_fecha(fecha_nacimiento, fecha) != ErrorFecha::ninguno) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    const long long dias_nacimiento = edad::fecha_a_dias(fecha.anio, fecha.mes, fecha.dia);
+
+    // Cálculo de la edad
+    return static_cast<double> (dias_referencia_ - dias_nacimiento) / DIAS_PROMEDIO_ANIO;
+}
+
+std::size_t edad::Calculadora::calcular_lote(const std::string_view* fechas, std::size_t n, double* edades) const noexcept {
+    // Bloques acotados en pila: parseo y conversión a días escriben en arreglos separados (SoA).
+    std::int32_t dias_nacimiento[LINEAS_POR_BLOQUE];
+    std::uint8_t validas[LINEAS_POR_BLOQUE];
+
+    std::size_t invalidas = 0u;
+    for (std::size_t base = 0u; base < n; base += LINEAS_POR_BLOQUE) {
+        const std::size_t cantidad = std::min(LINEAS_POR_BLOQUE, n - base);
+        invalidas += dias_bloque(fechas + base, cantidad, dias_nacimiento, validas);
+        for (std::size_t k = 0u; k < cantidad; ++k) {
+            edades[base + k] = validas[k] != 0u
+                    ? static_cast<double> (dias_referencia_ - dias_nacimiento[k]) / DIAS_PROMEDIO_ANIO
+                    : std::numeric_limits<double>::quiet_NaN();
+        }
+    }
+    return invalidas;
+}
+
+std::size_t edad::Calculadora::calcular_lote(const std::string* fechas, std::size_t n, double* edades) const noexcept {
+    std::string_view vistas[LINEAS_POR_BLOQUE];
+    std::size_t invalidas = 0u;
+    for (std::size_t base = 0u; base < n; base += LINEAS_POR_BLOQUE) {
+        const std::size_t cantidad = std::min(LINEAS_POR_BLOQUE, n - base);
+        for (std::size_t k = 0u; k < cantidad; ++k) {
+            vistas[k] = fechas[base + k];
+        }
+        invalidas += calcular_lote(vistas, cantidad, edades + base);
+    }
+    return invalidas;
+}
+
+void edad::Calculadora::clasificar_lote(const std::string_view* fechas, std::size_t n, std::int16_t* claves) const noexcept {
+    std::int32_t dias_nacimiento[LINEAS_POR_BLOQUE];
+    std::uint8_t validas[LINEAS_POR_BLOQUE];
+    const std::uint8_t* tabla = edad_por_dia_.data();
+    const std::uint32_t limite = static_cast<std::uint32_t> (edad_por_dia_.size());
+    const std::uint32_t referencia = static_cast<std::uint32_t> (dias_referencia_);
+
+    for (std::size_t base = 0u; base < n; base += LINEAS_POR_BLOQUE) {
+        const std::size_t cantidad = std::min(LINEAS_POR_BLOQUE, n - base);
+        std::int16_t* salida = claves + base;
+        dias_bloque(fechas + base, cantidad, dias_nacimiento, validas);
+
+        // parseo -> resta -> una lectura de tabla. Un desfase negativo (nacimiento futuro) se
+        // vuelve enorme como sin signo y queda fuera de la tabla igual que uno demasiado antiguo.
+        for (std::size_t k = 0u; k < cantidad; ++k) {
+            const std::uint32_t desfase = referencia - static_cast<std::uint32_t> (dias_nacimiento[k]);
+            const std::int16_t clave = desfase < limite ? static_cast<std::int16_t> (tabla[desfase]) : CLAVE_FUERA_RANGO;
+            salida[k] = validas[k] != 0u ? clave : CLAVE_INVALIDA;
+        }
+    }
+}
+
+std::int16_t edad::Calculadora::clasificar_dias(long long dias_nacimiento) const noexcept {
+    const long long desfase = dias_referencia_ - dias_nacimiento;
+    if (desfase < 0 || desfase >= static_cast<long long> (edad_por_dia_.size())) {
+        return CLAVE_FUERA_RANGO;
+    }
+    return static_cast<std::int16_t> (edad_por_dia_[static_cast<std::size_t> (desfase)]);
+}
+
+std::size_t edad::Calculadora::dias_tabla() const noexcept {
+    return edad_por_dia_.size();
+}
+
+int edad::Calculadora::edad_por_desfase(long long desfase) const noexcept {
+    if (modo_ == ModoEdad::exacta) {
+        // Años cumplidos: diferencia de años, menos uno si (mes, día) aún no llega en el año de referencia.
+        const Fecha nacimiento = edad::dias_a_fecha(dias_referencia_ - desfase);
+        const std::int32_t mes_dia = static_cast<std::int32_t> (nacimiento.mes * 32u + nacimiento.dia);
+        return anio_referencia_ - nacimiento.anio - static_cast<int> (mes_dia > mes_dia_referencia_);
+    }
+    // Mismo criterio que Calculadora::calcular: truncamiento de días / año promedio.
+    return static_cast<int> (static_cast<double> (desfase) / DIAS_PROMEDIO_ANIO);
+}
+
+double edad::calcular(const std::string& fecha_nacimiento) {
+    // Directo, sin construir una Calculadora: su tabla de edades (~48 KB) no se amortiza en una sola fecha.
+    Fecha fecha;
+    if (edad::parsear_fecha(fecha_nacimiento, fecha) != ErrorFecha::ninguno) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    const long long dias_nacimiento = edad::fecha_a_dias(fecha.anio, fecha.mes, fecha.dia);
+    return static_cast<double> (edad::dias_hoy() - dias_nacimiento) / DIAS_PROMEDIO_ANIO;
+}
@@ -20,13 +20,21 @@
  * Limitaciones:
  *   - La fracción decimal es un **promedio anual** y no corresponde exactamente
  *     al porcentaje transcurrido entre el último y próximo cumpleaños.
+ *
+ * Para histogramas existe además el modo @ref ModoEdad::exacta: años cumplidos según el
+ * calendario, comparando (mes, día) con la fecha de referencia, solo con aritmética entera.
  */
 
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <sstream>
 #include <chrono>
 #include <ctime>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <vector>
 
 
 namespace edad {
@@ -45,36 +53,264 @@ namespace edad {
      */
     long long fecha_a_dias( long long anio, unsigned int mes, unsigned int dia) noexcept;
 
+    /**
+     * @brief Cantidad de días del mes @p mes del año @p anio (calendario gregoriano proléptico).
+     *
+     * @param anio Año (ejemplo: 2004).
+     * @param mes Mes en rango [1..12].
+     * @return Días del mes (28..31).
+     */
+    unsigned int dias_del_mes(long long anio, unsigned int mes) noexcept;
+
+    /**
+     * @brief Causa por la que una fecha no pudo interpretarse.
+     */
+    enum class ErrorFecha : unsigned char {
+        ninguno = 0, ///< Fecha válida.
+        longitud, ///< Menos de 10 caracteres, o caracteres sobrantes tras la fecha.
+        separador, ///< Las posiciones 4 y 7 no contienen '-'.
+        digito, ///< Alguna posición de año, mes o día no es un dígito decimal.
+        mes, ///< Mes fuera de [1..12].
+        dia ///< Día fuera de [1..días del mes].
+    };
+
+    /**
+     * @brief Descripción legible de un @ref ErrorFecha.
+     */
+    const char* descripcion(ErrorFecha error) noexcept;
+
+    /**
+     * @brief Fecha civil ya validada.
+     */
+    struct Fecha {
+        int anio; ///< Año [0..9999].
+        unsigned int mes; ///< Mes [1..12].
+        unsigned int dia; ///< Día [1..31].
+    };
+
+    /**
+     * @brief Resultado de @ref parsear_fecha, al estilo de `std::from_chars_result`.
+     */
+    struct ResultadoFecha {
+        const char* ptr; ///< Primer carácter no consumido (o @c inicio si hubo error).
+        ErrorFecha error; ///< @ref ErrorFecha::ninguno si la fecha es válida.
+    };
+
+    /**
+     * @brief Inversa de @ref fecha_a_dias: fecha civil correspondiente a un contador de días.
+     *
+     * @param dias Número de días desde la época de @ref fecha_a_dias.
+     * @return Fecha civil (algoritmo civil_from_days de Howard Hinnant).
+     */
+    Fecha dias_a_fecha(long long dias) noexcept;
+
+    /**
+     * @brief Texto ISO "YYYY-MM-DD" del día @p dias (según @ref fecha_a_dias).
+     *
+     * @param dias Número de días desde la época de @ref fecha_a_dias.
+     * @return Fecha con año de al menos 4 dígitos, mes y día de 2 (ejemplo: "2005-01-06").
+     */
+    std::string formatear_fecha(long long dias);
+
+    /**
+     * @brief Parsea una fecha ISO "YYYY-MM-DD" al inicio de [@p inicio, @p fin), sin reservar memoria ni lanzar.
+     *
+     * @param inicio Primer carácter del texto.
+     * @param fin Uno más allá del último carácter disponible.
+     * @param fecha Destino; solo se escribe si la fecha es válida.
+     * @return `{inicio + 10, ErrorFecha::ninguno}` si la fecha es válida (sintaxis y calendario);
+     *         `{inicio, causa}` en caso contrario.
+     *
+     * @details
+     * Igual que `std::from_chars`, no exige consumir todo el texto: quien necesite que la línea
+     * contenga solo la fecha debe comprobar `ptr == fin`. Valida separadores, dígitos, rango del mes
+     * y días del mes (incluye años bisiestos).
+     */
+    ResultadoFecha parsear_fecha(const char* inicio, const char* fin, Fecha& fecha) noexcept;
+
+    /**
+     * @brief Parsea una línea que contiene exactamente una fecha ISO "YYYY-MM-DD".
+     *
+     * @param texto Línea completa (ejemplo: "2005-01-06").
+     * @param fecha Destino; solo se escribe si la fecha es válida.
+     * @return @ref ErrorFecha::ninguno si la línea es válida; la causa en caso contrario.
+     */
+    ErrorFecha parsear_fecha(std::string_view texto, Fecha& fecha) noexcept;
+
     /**
      * @brief Parsea una fecha en formato ISO "YYYY-MM-DD".
      *
      * @param texto Fecha como cadena (ejemplo: "2005-01-06").
      * @return Tupla con (anio, mes, dia).
      * @throws std::invalid_argument Si el formato no es válido.
+     *
+     * @note Envoltorio de @ref parsear_fecha para código que prefiere excepciones; en caminos
+     *       calientes usar directamente @ref parsear_fecha.
+     */
+    std::tuple<int, int, int> parsear_fecha_iso(std::string_view texto);
+
+    /**
+     * @brief Día (según @ref fecha_a_dias) correspondiente a la fecha local actual.
+     *
+     * @return Número de días de la fecha de hoy desde la época de @ref fecha_a_dias.
+     *
+     * @note Consulta `std::time` y `localtime_r` (zona horaria de glibc); no debe invocarse por línea.
+     */
+    long long dias_hoy();
+
+    /// Edad máxima (años enteros) considerada en los histogramas; claves válidas en [0, EDAD_MAXIMA].
+    constexpr int EDAD_MAXIMA = 130;
+
+    /// Clave de @ref Calculadora::clasificar_lote para una línea que no es una fecha válida.
+    constexpr std::int16_t CLAVE_INVALIDA = -1;
+
+    /// Clave de @ref Calculadora::clasificar_lote para una edad fuera de [0, EDAD_MAXIMA].
+    constexpr std::int16_t CLAVE_FUERA_RANGO = -2;
+
+    /// Tamaño de bloque sugerido para las API en lote: cabe en L1 junto con sus arreglos SoA.
+    constexpr std::size_t LINEAS_POR_BLOQUE = 256u;
+
+    /**
+     * @brief Criterio para discretizar la edad en años enteros.
      */
-    std::tuple<int, int, int> parsear_fecha_iso(const std::string& texto);
+    enum class ModoEdad : unsigned char {
+        /// Truncamiento de días transcurridos / 365.2425 (comportamiento histórico; división en coma flotante).
+        promedio,
+        /// Años cumplidos según el calendario: año de referencia − año de nacimiento, menos uno si aún no llega
+        /// el cumpleaños (comparación de (mes, día)). Solo aritmética entera. Un nacido un 29 de febrero cumple
+        /// el 1 de marzo en años no bisiestos.
+        exacta
+    };
+
+    /**
+     * @brief Calculadora de edades con una fecha de referencia fija.
+     *
+     * @details
+     * Resuelve la fecha de referencia ("hoy") **una sola vez** al construirse, de modo que el
+     * cálculo por línea no vuelva a consultar el reloj ni la zona horaria (con varios hilos,
+     * `localtime_r` se serializa internamente en glibc). La referencia es inyectable para
+     * obtener ejecuciones reproducibles.
+     *
+     * Es inmutable tras la construcción: una misma instancia puede compartirse entre hilos.
+     *
+     * @code{.cpp}
+     * const edad::Calculadora calculadora(2025, 1, 1);
+     * std::vector<std::string_view> fechas{"2005-01-06", "1990-12-31"};
+     * std::vector<double> edades(fechas.size());
+     * calculadora.calcular_lote(fechas.data(), fechas.size(), edades.data());
+     * @endcode
+     */
+    class Calculadora {
+    public:
+        /// Usa la fecha local actual (@ref dias_hoy) como referencia.
+        Calculadora();
+
+        /// Usa como referencia un día ya convertido con @ref fecha_a_dias.
+        explicit Calculadora(long long dias_referencia, ModoEdad modo = ModoEdad::promedio);
+
+        /// Usa como referencia la fecha civil (anio, mes, dia).
+        Calculadora(long long anio, unsigned int mes, unsigned int dia, ModoEdad modo = ModoEdad::promedio);
+
+        /// Día de referencia (según @ref fecha_a_dias).
+        long long dias_referencia() const noexcept;
+
+        /// Criterio de discretización usado por @ref clasificar_lote.
+        ModoEdad modo() const noexcept;
+
+        /**
+         * @brief Edad en años decimales respecto de la fecha de referencia.
+         * @param fecha_nacimiento Fecha ISO "YYYY-MM-DD".
+         * @return Edad decimal, o NaN si la fecha no es válida (no lanza).
+         */
+        double calcular(std::string_view fecha_nacimiento) const noexcept;
+
+        /**
+         * @brief Calcula en lote las edades de @p n fechas.
+         *
+         * @param fechas Arreglo contiguo de @p n fechas ISO (equivalente a un `span`).
+         * @param n Cantidad de fechas.
+         * @param edades Búfer del llamador con espacio para @p n resultados; `edades[i]` corresponde a `fechas[i]`
+         *        (NaN si la fecha no es válida).
+         * @return Cantidad de fechas inválidas del lote.
+         *
+         * @note El parseo usa el núcleo vectorizado de @ref parsear_fechas_lote (ver FechaSimd.h).
+         */
+        std::size_t calcular_lote(const std::string_view* fechas, std::size_t n, double* edades) const noexcept;
+
+        /// @copydoc calcular_lote(const std::string_view*, std::size_t, double*) const
+        std::size_t calcular_lote(const std::string* fechas, std::size_t n, double* edades) const noexcept;
+
+        /**
+         * @brief Clasifica en lote @p n fechas en claves de histograma (años enteros según @ref modo).
+         *
+         * @param fechas Arreglo contiguo de @p n fechas ISO.
+         * @param n Cantidad de fechas.
+         * @param claves Búfer del llamador con espacio para @p n claves: edad en [0, @ref EDAD_MAXIMA],
+         *        @ref CLAVE_INVALIDA o @ref CLAVE_FUERA_RANGO.
+         *
+         * @details
+         * Es la etapa de histograma en bloques: parseo SIMD (@ref parsear_fechas_lote), conversión SIMD
+         * a días (@ref fechas_a_dias_lote) y discretización, cada una sobre bloques de
+         * @ref LINEAS_POR_BLOQUE fechas en lugar de una llamada por línea.
+         * La discretización es una sola lectura de la tabla de edades (ver @ref clasificar_dias), igual
+         * para ambos modos: sin divisiones ni coma flotante por línea.
+         */
+        void clasificar_lote(const std::string_view* fechas, std::size_t n, std::int16_t* claves) const noexcept;
+
+        /**
+         * @brief Clave de histograma para un día de nacimiento (según @ref fecha_a_dias).
+         *
+         * @param dias_nacimiento Día de nacimiento.
+         * @return Edad en [0, @ref EDAD_MAXIMA] o @ref CLAVE_FUERA_RANGO.
+         *
+         * @details
+         * Consulta una tabla de `uint8_t` indexada por `dias_referencia() - dias_nacimiento`, construida una
+         * vez por calculadora con el criterio de @ref modo. Las edades [0, 130] cubren unos 47 850 días, así
+         * que la tabla ocupa ~48 KB y cabe en L2.
+         */
+        std::int16_t clasificar_dias(long long dias_nacimiento) const noexcept;
+
+        /**
+         * @brief Cantidad de días cubiertos por la tabla de edades.
+         * @details Los nacimientos en [dias_referencia() - dias_tabla() + 1, dias_referencia()] tienen edad en
+         *          [0, @ref EDAD_MAXIMA]; cualquier otro día es @ref CLAVE_FUERA_RANGO.
+         */
+        std::size_t dias_tabla() const noexcept;
+
+    private:
+        /// Edad (según @ref modo_) de quien nació @p desfase días antes de la referencia.
+        int edad_por_desfase(long long desfase) const noexcept;
+
+        long long dias_referencia_;
+        ModoEdad modo_;
+        std::int32_t anio_referencia_; ///< Año de la fecha de referencia (modo exacto).
+        std::int32_t mes_dia_referencia_; ///< mes * 32 + día de la fecha de referencia (modo exacto).
+        std::vector<std::uint8_t> edad_por_dia_; ///< Desfase en días -> edad en [0, EDAD_MAXIMA].
+    };
 
     /**
      * @brief Calcula la edad en años decimales a partir de la fecha de nacimiento.
      *
      * @param fecha_nacimiento Fecha de nacimiento en formato ISO "YYYY-MM-DD".
-     * @return Edad en años con fracción decimal (ejemplo: 20.75 aprox 20 años y 9 meses).
-     * @throws std::invalid_argument Si la fecha no respeta el formato ISO.
+     * @return Edad en años con fracción decimal (ejemplo: 20.75 aprox 20 años y 9 meses), o NaN si la fecha no es válida.
      *
      * @note La fracción decimal es una aproximación basada en el año promedio
      *       (365.2425 días). No corresponde exactamente al tiempo transcurrido
      *       entre cumpleaños.
+     * @note Consulta el reloj en cada invocación, pero no construye la tabla de edades de @ref Calculadora
+     *       (parseo y aritmética de días, sin memoria dinámica); para procesar muchas líneas usar @ref Calculadora.
      *
      * @code{.cpp}
      * #include "edad.hpp"
+     * #include <cmath>
      * #include <iostream>
      *
      * int main() {
-     *     try {
-     *         double edad = edad::calcular("2005-01-06");
+     *     double edad = edad::calcular("2005-01-06");
+     *     if (std::isnan(edad)) {
+     *         std::cerr << "Fecha inválida\n";
+     *     } else {
      *         std::cout << "Edad: " << edad << " años\n";
-     *     } catch (const std::exception& ex) {
-     *         std::cerr << "Error: " << ex.what() << '\n';
      *     }
      * }
      * @endcode
@@ -0,0 +1,108 @@
+#include "Espera.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <thread>
+
+namespace {
+
+    using Reloj = std::chrono::steady_clock;
+
+    /// Pista al núcleo de que se está girando (libera recursos al otro hilo SMT y evita la penalización al salir del giro).
+    inline void pausa() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__)
+        __asm__ __volatile__("yield");
+#endif
+    }
+
+    /// Imprime @p ns como milisegundos con un decimal.
+    void imprimir_ms(std::uint64_t ns, std::ostream& salida) {
+        salida << std::fixed << std::setprecision(1) << static_cast<double> (ns) / 1e6 << " ms";
+    }
+}
+
+void edad::Timbre::tocar() {
+    epoca_.fetch_add(1u, std::memory_order_seq_cst);
+    // Si nadie está estacionado no se toca el mutex: el costo habitual es un incremento atómico.
+    if (estacionados_.load(std::memory_order_seq_cst) > 0u) {
+        std::lock_guard<std::mutex> cerrojo(mutex_);
+        despertar_.notify_all();
+    }
+}
+
+std::uint64_t edad::Timbre::epoca() const noexcept {
+    return epoca_.load(std::memory_order_acquire);
+}
+
+void edad::Timbre::estacionar(std::uint64_t vista, std::chrono::nanoseconds limite) {
+    std::unique_lock<std::mutex> cerrojo(mutex_);
+    // Registrarse antes de releer la época: si tocar() no ve al estacionado, este sí ve la época nueva.
+    estacionados_.fetch_add(1u, std::memory_order_seq_cst);
+    despertar_.wait_for(cerrojo, limite, [this, vista]() {
+        return epoca_.load(std::memory_order_seq_cst) != vista;
+    });
+    estacionados_.fetch_sub(1u, std::memory_order_relaxed);
+}
+
+edad::Esperador::Esperador(PoliticaEspera politica, Timbre& timbre, ContadoresEspera& contadores) noexcept
+: politica_(politica), timbre_(timbre), contadores_(contadores), epoca_(timbre.epoca()) {
+}
+
+void edad::Esperador::esperar() {
+    const Reloj::time_point inicio = Reloj::now();
+    std::uint64_t* destino;
+    if (politica_ == PoliticaEspera::girar || (politica_ == PoliticaEspera::adaptativa && intentos_ < INTENTOS_GIRO)) {
+        // Giro exponencial: 1, 2, 4, ... hasta 64 pausas por intento.
+        const unsigned pausas = 1u << std::min(intentos_, 6u);
+        for (unsigned i = 0u; i < pausas; ++i) {
+            pausa();
+        }
+        destino = &contadores_.ns_giro;
+    } else if (politica_ == PoliticaEspera::ceder || intentos_ < INTENTOS_GIRO + INTENTOS_CESION) {
+        std::this_thread::yield();
+        destino = &contadores_.ns_cesion;
+    } else {
+        // epoca_ se leyó antes del último intento fallido: si cambió, hay trabajo nuevo y no se duerme.
+        timbre_.estacionar(epoca_, ESTACIONAMIENTO_MAXIMO);
+        ++contadores_.estacionamientos;
+        destino = &contadores_.ns_estacionado;
+    }
+    intentos_ = std::min(intentos_ + 1u, INTENTOS_GIRO + INTENTOS_CESION);
+    epoca_ = timbre_.epoca();
+    *destino += static_cast<std::uint64_t> (std::chrono::duration_cast<std::chrono::nanoseconds> (Reloj::now() - inicio).count());
+}
+
+void edad::Esperador::reiniciar() noexcept {
+    intentos_ = 0u;
+}
+
+void edad::imprimir_contadores_espera(const std::vector<ContadoresEspera>& contadores, std::ostream& salida) {
+    const std::ios::fmtflags banderas = salida.flags();
+    const std::streamsize precision = salida.precision();
+    ContadoresEspera total;
+    for (std::size_t hilo = 0u; hilo < contadores.size(); ++hilo) {
+        const ContadoresEspera& propios = contadores[hilo];
+        salida << "Espera del hilo " << hilo << ": giro ";
+        imprimir_ms(propios.ns_giro, salida);
+        salida << ", cesión ";
+        imprimir_ms(propios.ns_cesion, salida);
+        salida << ", estacionado ";
+        imprimir_ms(propios.ns_estacionado, salida);
+        salida << " (" << propios.estacionamientos << " veces)\n";
+        total.ns_giro += propios.ns_giro;
+        total.ns_cesion += propios.ns_cesion;
+        total.ns_estacionado += propios.ns_estacionado;
+        total.estacionamientos += propios.estacionamientos;
+    }
+    salida << "Espera total: giro ";
+    imprimir_ms(total.ns_giro, salida);
+    salida << ", cesión ";
+    imprimir_ms(total.ns_cesion, salida);
+    salida << ", estacionado ";
+    imprimir_ms(total.ns_estacionado, salida);
+    salida << " (" << total.estacionamientos << " veces)\n";
+    salida.flags(banderas);
+    salida.precision(precision);
+}
@@ -0,0 +1,122 @@
+#ifndef ESPERA_H
+#define ESPERA_H
+
+/**
+ * @file Espera.h
+ * @brief Políticas de espera para hilos del pipeline que no tienen trabajo (cola vacía o sin lotes libres).
+ *
+ * @details
+ * Con `std::this_thread::yield()` en bucle, un consumidor ocioso ocupa su núcleo al 100 %: si el lector es el
+ * cuello de botella, los consumidores le quitan CPU a él y a otros procesos del equipo. La política
+ * `adaptativa` escala en tres fases:
+ * 1. **Giro**: reintenta tras unas pocas instrucciones `pause` (cantidad creciente); reacciona en
+ *    nanosegundos cuando la espera es breve y no cede el núcleo.
+ * 2. **Cesión**: `yield()`; deja correr a otros hilos listos, pero el hilo sigue planificable.
+ * 3. **Estacionamiento**: duerme en un @ref Timbre hasta que quien produce lo toque (o, por seguridad,
+ *    hasta `ESTACIONAMIENTO_MAXIMO`); no consume CPU.
+ *
+ * ### Timbre y despertares perdidos
+ * El @ref Timbre es un contador de eventos (*eventcount*): quien publica trabajo incrementa la época y, solo si
+ * hay hilos estacionados, toma el mutex y notifica. Un @ref Esperador recuerda la época que leyó **antes** de su
+ * último intento fallido; si al estacionar la época ya cambió, hubo trabajo nuevo entre medio y no duerme.
+ *
+ * @code{.cpp}
+ * edad::Esperador espera(politica, timbre, contadores[hilo]);
+ * for (;;) {
+ *     if (cola.desencolar(x, hilo)) { espera.reiniciar(); ... }
+ *     else if (terminado && cola.vacia()) break;
+ *     else espera.esperar();
+ * }
+ * // productor: cola.encolar(x); timbre.tocar(); ... terminado = true; timbre.tocar();
+ * @endcode
+ */
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+namespace edad {
+
+    /**
+     * @brief Cómo espera un hilo sin trabajo.
+     */
+    enum class PoliticaEspera {
+        ceder, ///< Solo `yield()` (comportamiento histórico).
+        girar, ///< Solo giro con `pause` (mínima latencia, un núcleo ocupado por hilo).
+        adaptativa ///< Giro, luego `yield()`, luego estacionamiento en un @ref Timbre.
+    };
+
+    /// Intentos fallidos que se resuelven girando antes de pasar a ceder (política adaptativa).
+    constexpr unsigned INTENTOS_GIRO = 16u;
+
+    /// Intentos fallidos adicionales que se resuelven con `yield()` antes de estacionar (política adaptativa).
+    constexpr unsigned INTENTOS_CESION = 16u;
+
+    /// Tope de un estacionamiento sin toque del timbre (red de seguridad, no mecanismo de despertar).
+    constexpr std::chrono::milliseconds ESTACIONAMIENTO_MAXIMO{50};
+
+    /**
+     * @brief Tiempo de espera de un hilo por fase, en nanosegundos. Alineado a línea de caché para poder
+     *        guardarse en un vector indexado por hilo sin *false sharing*.
+     */
+    struct alignas(64) ContadoresEspera {
+        std::uint64_t ns_giro = 0u;
+        std::uint64_t ns_cesion = 0u;
+        std::uint64_t ns_estacionado = 0u;
+        std::uint64_t estacionamientos = 0u;
+    };
+
+    /**
+     * @brief Punto de encuentro entre quien publica trabajo y los hilos estacionados esperándolo. Thread-safe.
+     */
+    class Timbre {
+    public:
+        /// Avisa que hay trabajo nuevo (o un cambio de estado, como el fin del productor).
+        void tocar();
+
+        /// Época actual; cambia en cada @ref tocar.
+        std::uint64_t epoca() const noexcept;
+
+        /// Duerme mientras la época sea @p vista, hasta @p limite como máximo.
+        void estacionar(std::uint64_t vista, std::chrono::nanoseconds limite);
+
+    private:
+        std::atomic<std::uint64_t> epoca_{0u};
+        std::atomic<unsigned> estacionados_{0u};
+        std::mutex mutex_;
+        std::condition_variable despertar_;
+    };
+
+    /**
+     * @brief Estado de espera de un hilo (no thread-safe: uno por hilo).
+     */
+    class Esperador {
+    public:
+        /// @p timbre y @p contadores deben sobrevivir al esperador.
+        Esperador(PoliticaEspera politica, Timbre& timbre, ContadoresEspera& contadores) noexcept;
+
+        /// Espera un poco tras un intento fallido, según la política y los intentos previos.
+        void esperar();
+
+        /// Registra un intento exitoso: la próxima espera vuelve a empezar por la primera fase.
+        void reiniciar() noexcept;
+
+    private:
+        PoliticaEspera politica_;
+        Timbre& timbre_;
+        ContadoresEspera& contadores_;
+        unsigned intentos_ = 0u;
+        std::uint64_t epoca_ = 0u;
+    };
+
+    /**
+     * @brief Imprime una línea por hilo con el tiempo girando, cediendo y estacionado, y el total.
+     */
+    void imprimir_contadores_espera(const std::vector<ContadoresEspera>& contadores, std::ostream& salida);
+}
+
+#endif /* ESPERA_H */
@@ -0,0 +1,426 @@
+#include "FechaSimd.h"
+
+#include <cstdlib>
+#include <cstring>
+
+#include "Edad.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define EDAD_SIMD_X86 1
+#endif
+
+namespace {
+
+    /// Bytes por ranura: una fecha de 10 bytes rellenada a 16 (un registro de 128 bits).
+    constexpr std::size_t RANURA = 16u;
+
+    /// Bits (de `movemask`) de las posiciones con dígitos en "YYYY-MM-DD": 0,1,2,3,5,6,8,9.
+    constexpr unsigned MASCARA_DIGITOS = 0x36Fu;
+
+    /// Bits de las posiciones de los separadores '-': 4 y 7.
+    constexpr unsigned MASCARA_SEPARADORES = 0x090u;
+
+    /// Las 10 posiciones de la fecha correctas.
+    constexpr unsigned MASCARA_FECHA = 0x3FFu;
+
+    /// Inverso multiplicativo de 25 módulo 2^32: `y % 25 == 0` ⇔ `y * INVERSO_25 <= UMBRAL_25` (sin dividir).
+    constexpr std::uint32_t INVERSO_25 = 0xC28F5C29u;
+    constexpr std::uint32_t UMBRAL_25 = 0xFFFFFFFFu / 25u;
+
+    /**
+     * @brief Copia @p n fechas a ranuras de 16 bytes; las de longitud distinta de 10 quedan en cero (inválidas).
+     * @details Evita leer más allá del final de cada texto (la última línea de un archivo mapeado no tiene relleno).
+     */
+    inline void preparar_ranuras(const std::string_view* textos, std::size_t n, unsigned char* ranuras) noexcept {
+        for (std::size_t k = 0u; k < n; ++k) {
+            unsigned char* ranura = ranuras + k * RANURA;
+            if (textos[k].size() == 10u) {
+                std::memcpy(ranura, textos[k].data(), 10u);
+                std::memset(ranura + 10, 0, RANURA - 10u);
+            } else {
+                std::memset(ranura, 0, RANURA);
+            }
+        }
+    }
+
+    std::size_t nucleo_escalar(const std::string_view* textos, std::size_t n,
+            std::int32_t* anios, std::int32_t* meses, std::int32_t* dias, std::uint8_t* validas) noexcept {
+        std::size_t invalidas = 0u;
+        for (std::size_t i = 0u; i < n; ++i) {
+            edad::Fecha fecha{};
+            const bool valida = edad::parsear_fecha(textos[i], fecha) == edad::ErrorFecha::ninguno;
+            anios[i] = fecha.anio;
+            meses[i] = static_cast<std::int32_t> (fecha.mes);
+            dias[i] = static_cast<std::int32_t> (fecha.dia);
+            validas[i] = valida ? 1u : 0u;
+            invalidas += valida ? 0u : 1u;
+        }
+        return invalidas;
+    }
+
+    void dias_escalar(const std::int32_t* anios, const std::int32_t* meses, const std::int32_t* dias,
+            std::size_t n, std::int32_t* salida) noexcept {
+        for (std::size_t i = 0u; i < n; ++i) {
+            salida[i] = static_cast<std::int32_t> (edad::fecha_a_dias(anios[i], static_cast<unsigned> (meses[i]), static_cast<unsigned> (dias[i])));
+        }
+    }
+
+#ifdef EDAD_SIMD_X86
+
+    /// (año, mes, día, 0) en 32 bits a partir de los dígitos de una ranura ya restada de '0'.
+    __attribute__((target("sse4.2")))
+    inline __m128i componer_sse42(__m128i digitos) noexcept {
+        const __m128i orden = _mm_setr_epi8(0, 1, 2, 3, 5, 6, -1, -1, 8, 9, -1, -1, -1, -1, -1, -1);
+        const __m128i decenas = _mm_setr_epi8(10, 1, 10, 1, 10, 1, 0, 0, 10, 1, 0, 0, 0, 0, 0, 0);
+        const __m128i centenas = _mm_setr_epi16(100, 1, 1, 0, 1, 0, 0, 0);
+        return _mm_madd_epi16(_mm_maddubs_epi16(_mm_shuffle_epi8(digitos, orden), decenas), centenas);
+    }
+
+    std::size_t __attribute__((target("sse4.2"))) nucleo_sse42(const std::string_view* textos, std::size_t n,
+            std::int32_t* anios, std::int32_t* meses, std::int32_t* dias, std::uint8_t* validas) noexcept {
+        constexpr std::size_t LOTE = 4u;
+        alignas(16) unsigned char ranuras[LOTE * RANURA];
+        const __m128i cero_ascii = _mm_set1_epi8('0');
+        const __m128i nueve = _mm_set1_epi8(9);
+        const __m128i guion = _mm_set1_epi8('-');
+        const __m128i tabla_dias = _mm_setr_epi8(0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31, 0, 0, 0);
+        const __m128i byte_bajo = _mm_set1_epi32(0xFF);
+        const __m128i inverso_25 = _mm_set1_epi32(static_cast<int> (INVERSO_25));
+        const __m128i umbral_25 = _mm_set1_epi32(static_cast<int> (UMBRAL_25));
+
+        std::size_t invalidas = 0u;
+        std::size_t i = 0u;
+        for (; i + LOTE <= n; i += LOTE) {
+            preparar_ranuras(textos + i, LOTE, ranuras);
+
+            // Sintaxis y composición: una fecha por registro.
+            __m128i r[LOTE];
+            unsigned sintaxis = 0u;
+            for (std::size_t k = 0u; k < LOTE; ++k) {
+                const __m128i texto = _mm_load_si128(reinterpret_cast<const __m128i*> (ranuras + k * RANURA));
+                const __m128i digitos = _mm_sub_epi8(texto, cero_ascii);
+                const unsigned es_digito = static_cast<unsigned> (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(digitos, nueve), digitos)));
+                const unsigned es_guion = static_cast<unsigned> (_mm_movemask_epi8(_mm_cmpeq_epi8(texto, guion)));
+                const unsigned correctas = (es_digito & MASCARA_DIGITOS) | (es_guion & MASCARA_SEPARADORES);
+                sintaxis |= static_cast<unsigned> (correctas == MASCARA_FECHA) << k;
+                r[k] = componer_sse42(digitos);
+            }
+
+            // Transposición 4x4: (Y,M,D,0) por fecha -> Y, M, D por registro.
+            const __m128i t0 = _mm_unpacklo_epi32(r[0], r[1]);
+            const __m128i t1 = _mm_unpacklo_epi32(r[2], r[3]);
+            const __m128i t2 = _mm_unpackhi_epi32(r[0], r[1]);
+            const __m128i t3 = _mm_unpackhi_epi32(r[2], r[3]);
+            const __m128i y = _mm_unpacklo_epi64(t0, t1);
+            const __m128i m = _mm_unpackhi_epi64(t0, t1);
+            const __m128i d = _mm_unpacklo_epi64(t2, t3);
+
+            // Calendario: mes en [1..12], día en [1..días del mes] (+1 en febrero bisiesto).
+            const __m128i mes_ok = _mm_and_si128(_mm_cmpgt_epi32(m, _mm_setzero_si128()), _mm_cmpgt_epi32(_mm_set1_epi32(13), m));
+            const __m128i producto = _mm_mullo_epi32(y, inverso_25);
+            const __m128i div25 = _mm_cmpeq_epi32(_mm_min_epu32(producto, umbral_25), producto);
+            const __m128i div4 = _mm_cmpeq_epi32(_mm_and_si128(y, _mm_set1_epi32(3)), _mm_setzero_si128());
+            const __m128i div16 = _mm_cmpeq_epi32(_mm_and_si128(y, _mm_set1_epi32(15)), _mm_setzero_si128());
+            const __m128i bisiesto = _mm_and_si128(div4, _mm_or_si128(_mm_andnot_si128(div25, _mm_set1_epi32(-1)), div16));
+            const __m128i febrero_bisiesto = _mm_and_si128(_mm_cmpeq_epi32(m, _mm_set1_epi32(2)), bisiesto);
+            const __m128i dias_mes = _mm_sub_epi32(_mm_and_si128(_mm_shuffle_epi8(tabla_dias, m), byte_bajo), febrero_bisiesto);
+            const __m128i dia_ok = _mm_and_si128(_mm_cmpgt_epi32(d, _mm_setzero_si128()), _mm_cmpgt_epi32(_mm_add_epi32(dias_mes, _mm_set1_epi32(1)), d));
+            const unsigned calendario = static_cast<unsigned> (_mm_movemask_ps(_mm_castsi128_ps(_mm_and_si128(mes_ok, dia_ok))));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*> (anios + i), y);
+            _mm_storeu_si128(reinterpret_cast<__m128i*> (meses + i), m);
+            _mm_storeu_si128(reinterpret_cast<__m128i*> (dias + i), d);
+            const unsigned correctas = sintaxis & calendario;
+            for (std::size_t k = 0u; k < LOTE; ++k) {
+                validas[i + k] = static_cast<std::uint8_t> ((correctas >> k) & 1u);
+            }
+            invalidas += LOTE - static_cast<std::size_t> (__builtin_popcount(correctas));
+        }
+        return invalidas + nucleo_escalar(textos + i, n - i, anios + i, meses + i, dias + i, validas + i);
+    }
+
+    /**
+     * @brief days_from_civil de Hinnant en 4 carriles de 32 bits.
+     * @details Las ramas del algoritmo escalar se reemplazan por máscaras: `mes <= 2` (ajuste de año y de mes)
+     * y era negativa (corrimiento de -399 antes de truncar). Las divisiones por 400 usan `divps` (exacta para
+     * |año| < 2^24); por 5 y por 100 se hacen con multiplicación y corrimiento (exactas en los rangos usados).
+     */
+    void __attribute__((target("sse4.2"))) dias_sse42(const std::int32_t* anios, const std::int32_t* meses, const std::int32_t* dias,
+            std::size_t n, std::int32_t* salida) noexcept {
+        const __m128i tres = _mm_set1_epi32(3);
+        std::size_t i = 0u;
+        for (; i + 4u <= n; i += 4u) {
+            const __m128i m = _mm_loadu_si128(reinterpret_cast<const __m128i*> (meses + i));
+            const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*> (dias + i));
+            const __m128i enero_febrero = _mm_cmpgt_epi32(tres, m);
+            const __m128i y = _mm_add_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*> (anios + i)), enero_febrero);
+            const __m128i corrimiento = _mm_and_si128(_mm_cmpgt_epi32(_mm_setzero_si128(), y), _mm_set1_epi32(-399));
+            const __m128i era = _mm_cvttps_epi32(_mm_div_ps(_mm_cvtepi32_ps(_mm_add_epi32(y, corrimiento)), _mm_set1_ps(400.0f)));
+            const __m128i anio_era = _mm_sub_epi32(y, _mm_mullo_epi32(era, _mm_set1_epi32(400)));
+            const __m128i mes_marzo = _mm_add_epi32(_mm_sub_epi32(m, tres), _mm_and_si128(enero_febrero, _mm_set1_epi32(12)));
+            const __m128i x = _mm_add_epi32(_mm_mullo_epi32(mes_marzo, _mm_set1_epi32(153)), _mm_set1_epi32(2));
+            const __m128i dia_anio = _mm_add_epi32(_mm_srli_epi32(_mm_mullo_epi32(x, _mm_set1_epi32(13108)), 16), _mm_sub_epi32(d, _mm_set1_epi32(1)));
+            const __m128i centurias = _mm_srli_epi32(_mm_mullo_epi32(anio_era, _mm_set1_epi32(5243)), 19);
+            const __m128i dias_era = _mm_add_epi32(_mm_sub_epi32(_mm_add_epi32(_mm_mullo_epi32(anio_era, _mm_set1_epi32(365)), _mm_srli_epi32(anio_era, 2)), centurias), dia_anio);
+            const __m128i resultado = _mm_add_epi32(_mm_mullo_epi32(era, _mm_set1_epi32(146097)), _mm_sub_epi32(dias_era, _mm_set1_epi32(719468)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*> (salida + i), resultado);
+        }
+        dias_escalar(anios + i, meses + i, dias + i, n - i, salida + i);
+    }
+
+    std::size_t __attribute__((target("avx2"))) nucleo_avx2(const std::string_view* textos, std::size_t n,
+            std::int32_t* anios, std::int32_t* meses, std::int32_t* dias, std::uint8_t* validas) noexcept {
+        constexpr std::size_t LOTE = 8u;
+        alignas(32) unsigned char ranuras[LOTE * RANURA];
+        const __m256i cero_ascii = _mm256_set1_epi8('0');
+        const __m256i nueve = _mm256_set1_epi8(9);
+        const __m256i guion = _mm256_set1_epi8('-');
+        const __m256i orden = _mm256_broadcastsi128_si256(_mm_setr_epi8(0, 1, 2, 3, 5, 6, -1, -1, 8, 9, -1, -1, -1, -1, -1, -1));
+        const __m256i decenas = _mm256_broadcastsi128_si256(_mm_setr_epi8(10, 1, 10, 1, 10, 1, 0, 0, 10, 1, 0, 0, 0, 0, 0, 0));
+        const __m256i centenas = _mm256_broadcastsi128_si256(_mm_setr_epi16(100, 1, 1, 0, 1, 0, 0, 0));
+        const __m256i tabla_dias = _mm256_broadcastsi128_si256(_mm_setr_epi8(0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31, 0, 0, 0));
+        // Deshace el entrelazado de la transposición por carriles de 128 bits.
+        const __m256i reordenar = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+        const __m256i byte_bajo = _mm256_set1_epi32(0xFF);
+        const __m256i inverso_25 = _mm256_set1_epi32(static_cast<int> (INVERSO_25));
+        const __m256i umbral_25 = _mm256_set1_epi32(static_cast<int> (UMBRAL_25));
+        const __m256i cero = _mm256_setzero_si256();
+
+        std::size_t invalidas = 0u;
+        std::size_t i = 0u;
+        for (; i + LOTE <= n; i += LOTE) {
+            preparar_ranuras(textos + i, LOTE, ranuras);
+
+            // Sintaxis y composición: dos fechas por registro.
+            __m256i r[4];
+            unsigned sintaxis = 0u;
+            for (std::size_t k = 0u; k < 4u; ++k) {
+                const __m256i texto = _mm256_load_si256(reinterpret_cast<const __m256i*> (ranuras + 2u * k * RANURA));
+                const __m256i digitos = _mm256_sub_epi8(texto, cero_ascii);
+                const unsigned es_digito = static_cast<unsigned> (_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_min_epu8(digitos, nueve), digitos)));
+                const unsigned es_guion = static_cast<unsigned> (_mm256_movemask_epi8(_mm256_cmpeq_epi8(texto, guion)));
+                const unsigned correctas = (es_digito & (MASCARA_DIGITOS * 0x10001u)) | (es_guion & (MASCARA_SEPARADORES * 0x10001u));
+                sintaxis |= static_cast<unsigned> ((correctas & MASCARA_FECHA) == MASCARA_FECHA) << (2u * k);
+                sintaxis |= static_cast<unsigned> ((correctas >> 16) == MASCARA_FECHA) << (2u * k + 1u);
+                r[k] = _mm256_madd_epi16(_mm256_maddubs_epi16(_mm256_shuffle_epi8(digitos, orden), decenas), centenas);
+            }
+
+            // Transposición por carril y reordenamiento final a fechas 0..7.
+            const __m256i t0 = _mm256_unpacklo_epi32(r[0], r[1]);
+            const __m256i t1 = _mm256_unpacklo_epi32(r[2], r[3]);
+            const __m256i t2 = _mm256_unpackhi_epi32(r[0], r[1]);
+            const __m256i t3 = _mm256_unpackhi_epi32(r[2], r[3]);
+            const __m256i y = _mm256_permutevar8x32_epi32(_mm256_unpacklo_epi64(t0, t1), reordenar);
+            const __m256i m = _mm256_permutevar8x32_epi32(_mm256_unpackhi_epi64(t0, t1), reordenar);
+            const __m256i d = _mm256_permutevar8x32_epi32(_mm256_unpacklo_epi64(t2, t3), reordenar);
+
+            const __m256i mes_ok = _mm256_and_si256(_mm256_cmpgt_epi32(m, cero), _mm256_cmpgt_epi32(_mm256_set1_epi32(13), m));
+            const __m256i producto = _mm256_mullo_epi32(y, inverso_25);
+            const __m256i div25 = _mm256_cmpeq_epi32(_mm256_min_epu32(producto, umbral_25), producto);
+            const __m256i div4 = _mm256_cmpeq_epi32(_mm256_and_si256(y, _mm256_set1_epi32(3)), cero);
+            const __m256i div16 = _mm256_cmpeq_epi32(_mm256_and_si256(y, _mm256_set1_epi32(15)), cero);
+            const __m256i bisiesto = _mm256_and_si256(div4, _mm256_or_si256(_mm256_andnot_si256(div25, _mm256_set1_epi32(-1)), div16));
+            const __m256i febrero_bisiesto = _mm256_and_si256(_mm256_cmpeq_epi32(m, _mm256_set1_epi32(2)), bisiesto);
+            const __m256i dias_mes = _mm256_sub_epi32(_mm256_and_si256(_mm256_shuffle_epi8(tabla_dias, m), byte_bajo), febrero_bisiesto);
+            const __m256i dia_ok = _mm256_and_si256(_mm256_cmpgt_epi32(d, cero), _mm256_cmpgt_epi32(_mm256_add_epi32(dias_mes, _mm256_set1_epi32(1)), d));
+            const unsigned calendario = static_cast<unsigned> (_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_and_si256(mes_ok, dia_ok))));
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*> (anios + i), y);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*> (meses + i), m);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*> (dias + i), d);
+            const unsigned correctas = sintaxis & calendario;
+            for (std::size_t k = 0u; k < LOTE; ++k) {
+                validas[i + k] = static_cast<std::uint8_t> ((correctas >> k) & 1u);
+            }
+            invalidas += LOTE - static_cast<std::size_t> (__builtin_popcount(correctas));
+        }
+        return invalidas + nucleo_escalar(textos + i, n - i, anios + i, meses + i, dias + i, validas + i);
+    }
+
+    /// @copydoc dias_sse42
+    void __attribute__((target("avx2"))) dias_avx2(const std::int32_t* anios, const std::int32_t* meses, const std::int32_t* dias,
+            std::size_t n, std::int32_t* salida) noexcept {
+        const __m256i tres = _mm256_set1_epi32(3);
+        std::size_t i = 0u;
+        for (; i + 8u <= n; i += 8u) {
+            const __m256i m = _mm256_loadu_si256(reinterpret_cast<const __m256i*> (meses + i));
+            const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*> (dias + i));
+            const __m256i enero_febrero = _mm256_cmpgt_epi32(tres, m);
+            const __m256i y = _mm256_add_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*> (anios + i)), enero_febrero);
+            const __m256i corrimiento = _mm256_and_si256(_mm256_cmpgt_epi32(_mm256_setzero_si256(), y), _mm256_set1_epi32(-399));
+            const __m256i era = _mm256_cvttps_epi32(_mm256_div_ps(_mm256_cvtepi32_ps(_mm256_add_epi32(y, corrimiento)), _mm256_set1_ps(400.0f)));
+            const __m256i anio_era = _mm256_sub_epi32(y, _mm256_mullo_epi32(era, _mm256_set1_epi32(400)));
+            const __m256i mes_marzo = _mm256_add_epi32(_mm256_sub_epi32(m, tres), _mm256_and_si256(enero_febrero, _mm256_set1_epi32(12)));
+            const __m256i x = _mm256_add_epi32(_mm256_mullo_epi32(mes_marzo, _mm256_set1_epi32(153)), _mm256_set1_epi32(2));
+            const __m256i dia_anio = _mm256_add_epi32(_mm256_srli_epi32(_mm256_mullo_epi32(x, _mm256_set1_epi32(13108)), 16), _mm256_sub_epi32(d, _mm256_set1_epi32(1)));
+            const __m256i centurias = _mm256_srli_epi32(_mm256_mullo_epi32(anio_era, _mm256_set1_epi32(5243)), 19);
+            const __m256i dias_era = _mm256_add_epi32(_mm256_sub_epi32(_mm256_add_epi32(_mm256_mullo_epi32(anio_era, _mm256_set1_epi32(365)), _mm256_srli_epi32(anio_era, 2)), centurias), dia_anio);
+            const __m256i resultado = _mm256_add_epi32(_mm256_mullo_epi32(era, _mm256_set1_epi32(146097)), _mm256_sub_epi32(dias_era, _mm256_set1_epi32(719468)));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*> (salida + i), resultado);
+        }
+        dias_escalar(anios + i, meses + i, dias + i, n - i, salida + i);
+    }
+
+    // GCC 12 emite falsos -Wuninitialized dentro de sus propios intrínsecos AVX-512 (`_mm512_undefined_epi32`).
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+    std::size_t __attribute__((target("avx512f,avx512bw"))) nucleo_avx512(const std::string_view* textos, std::size_t n,
+            std::int32_t* anios, std::int32_t* meses, std::int32_t* dias, std::uint8_t* validas) noexcept {
+        constexpr std::size_t LOTE = 16u;
+        alignas(64) unsigned char ranuras[LOTE * RANURA];
+        const __m512i cero_ascii = _mm512_set1_epi8('0');
+        const __m512i nueve = _mm512_set1_epi8(9);
+        const __m512i guion = _mm512_set1_epi8('-');
+        const __m512i orden = _mm512_broadcast_i32x4(_mm_setr_epi8(0, 1, 2, 3, 5, 6, -1, -1, 8, 9, -1, -1, -1, -1, -1, -1));
+        const __m512i decenas = _mm512_broadcast_i32x4(_mm_setr_epi8(10, 1, 10, 1, 10, 1, 0, 0, 10, 1, 0, 0, 0, 0, 0, 0));
+        const __m512i centenas = _mm512_broadcast_i32x4(_mm_setr_epi16(100, 1, 1, 0, 1, 0, 0, 0));
+        const __m512i tabla_dias = _mm512_broadcast_i32x4(_mm_setr_epi8(0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31, 0, 0, 0));
+        // Posición i <- fecha i: el carril j, elemento k de la transposición contiene la fecha 4k + j.
+        const __m512i reordenar = _mm512_setr_epi32(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+        const __m512i byte_bajo = _mm512_set1_epi32(0xFF);
+        const __m512i inverso_25 = _mm512_set1_epi32(static_cast<int> (INVERSO_25));
+        const __m512i umbral_25 = _mm512_set1_epi32(static_cast<int> (UMBRAL_25));
+        const std::uint64_t digitos_x4 = MASCARA_DIGITOS * 0x0001000100010001ull;
+        const std::uint64_t separadores_x4 = MASCARA_SEPARADORES * 0x0001000100010001ull;
+
+        std::size_t invalidas = 0u;
+        std::size_t i = 0u;
+        for (; i + LOTE <= n; i += LOTE) {
+            preparar_ranuras(textos + i, LOTE, ranuras);
+
+            // Sintaxis y composición: cuatro fechas por registro.
+            __m512i r[4];
+            unsigned sintaxis = 0u;
+            for (std::size_t k = 0u; k < 4u; ++k) {
+                const __m512i texto = _mm512_load_si512(ranuras + 4u * k * RANURA);
+                const __m512i digitos = _mm512_sub_epi8(texto, cero_ascii);
+                const std::uint64_t es_digito = _mm512_cmple_epu8_mask(digitos, nueve);
+                const std::uint64_t es_guion = _mm512_cmpeq_epi8_mask(texto, guion);
+                const std::uint64_t correctas = (es_digito & digitos_x4) | (es_guion & separadores_x4);
+                for (unsigned j = 0u; j < 4u; ++j) {
+                    sintaxis |= static_cast<unsigned> (((correctas >> (16u * j)) & MASCARA_FECHA) == MASCARA_FECHA) << (4u * k + j);
+                }
+                r[k] = _mm512_madd_epi16(_mm512_maddubs_epi16(_mm512_shuffle_epi8(digitos, orden), decenas), centenas);
+            }
+
+            const __m512i t0 = _mm512_unpacklo_epi32(r[0], r[1]);
+            const __m512i t1 = _mm512_unpacklo_epi32(r[2], r[3]);
+            const __m512i t2 = _mm512_unpackhi_epi32(r[0], r[1]);
+            const __m512i t3 = _mm512_unpackhi_epi32(r[2], r[3]);
+            const __m512i y = _mm512_permutexvar_epi32(reordenar, _mm512_unpacklo_epi64(t0, t1));
+            const __m512i m = _mm512_permutexvar_epi32(reordenar, _mm512_unpackhi_epi64(t0, t1));
+            const __m512i d = _mm512_permutexvar_epi32(reordenar, _mm512_unpacklo_epi64(t2, t3));
+
+            const __mmask16 mes_ok = _mm512_cmpgt_epi32_mask(m, _mm512_setzero_si512()) & _mm512_cmplt_epi32_mask(m, _mm512_set1_epi32(13));
+            const __mmask16 div25 = _mm512_cmple_epu32_mask(_mm512_mullo_epi32(y, inverso_25), umbral_25);
+            const __mmask16 div4 = _mm512_testn_epi32_mask(y, _mm512_set1_epi32(3));
+            const __mmask16 div16 = _mm512_testn_epi32_mask(y, _mm512_set1_epi32(15));
+            const __mmask16 febrero_bisiesto = _mm512_cmpeq_epi32_mask(m, _mm512_set1_epi32(2)) & div4 & static_cast<__mmask16> (~div25 | div16);
+            const __m512i dias_base = _mm512_and_si512(_mm512_shuffle_epi8(tabla_dias, m), byte_bajo);
+            const __m512i dias_mes = _mm512_mask_add_epi32(dias_base, febrero_bisiesto, dias_base, _mm512_set1_epi32(1));
+            const __mmask16 dia_ok = _mm512_cmpgt_epi32_mask(d, _mm512_setzero_si512()) & _mm512_cmple_epi32_mask(d, dias_mes);
+
+            _mm512_storeu_si512(anios + i, y);
+            _mm512_storeu_si512(meses + i, m);
+            _mm512_storeu_si512(dias + i, d);
+            const unsigned correctas = sintaxis & static_cast<unsigned> (mes_ok & dia_ok);
+            for (std::size_t k = 0u; k < LOTE; ++k) {
+                validas[i + k] = static_cast<std::uint8_t> ((correctas >> k) & 1u);
+            }
+            invalidas += LOTE - static_cast<std::size_t> (__builtin_popcount(correctas));
+        }
+        return invalidas + nucleo_escalar(textos + i, n - i, anios + i, meses + i, dias + i, validas + i);
+    }
+
+    /// @copydoc dias_sse42
+    void __attribute__((target("avx512f,avx512bw"))) dias_avx512(const std::int32_t* anios, const std::int32_t* meses, const std::int32_t* dias,
+            std::size_t n, std::int32_t* salida) noexcept {
+        const __m512i tres = _mm512_set1_epi32(3);
+        std::size_t i = 0u;
+        for (; i + 16u <= n; i += 16u) {
+            const __m512i m = _mm512_loadu_si512(meses + i);
+            const __m512i d = _mm512_loadu_si512(dias + i);
+            const __mmask16 enero_febrero = _mm512_cmplt_epi32_mask(m, tres);
+            const __m512i y0 = _mm512_loadu_si512(anios + i);
+            const __m512i y = _mm512_mask_sub_epi32(y0, enero_febrero, y0, _mm512_set1_epi32(1));
+            const __m512i ajustado = _mm512_mask_sub_epi32(y, _mm512_cmplt_epi32_mask(y, _mm512_setzero_si512()), y, _mm512_set1_epi32(399));
+            const __m512i era = _mm512_cvttps_epi32(_mm512_div_ps(_mm512_cvtepi32_ps(ajustado), _mm512_set1_ps(400.0f)));
+            const __m512i anio_era = _mm512_sub_epi32(y, _mm512_mullo_epi32(era, _mm512_set1_epi32(400)));
+            const __m512i mes_marzo = _mm512_mask_add_epi32(_mm512_sub_epi32(m, tres), enero_febrero, _mm512_sub_epi32(m, tres), _mm512_set1_epi32(12));
+            const __m512i x = _mm512_add_epi32(_mm512_mullo_epi32(mes_marzo, _mm512_set1_epi32(153)), _mm512_set1_epi32(2));
+            const __m512i dia_anio = _mm512_add_epi32(_mm512_srli_epi32(_mm512_mullo_epi32(x, _mm512_set1_epi32(13108)), 16), _mm512_sub_epi32(d, _mm512_set1_epi32(1)));
+            const __m512i centurias = _mm512_srli_epi32(_mm512_mullo_epi32(anio_era, _mm512_set1_epi32(5243)), 19);
+            const __m512i dias_era = _mm512_add_epi32(_mm512_sub_epi32(_mm512_add_epi32(_mm512_mullo_epi32(anio_era, _mm512_set1_epi32(365)), _mm512_srli_epi32(anio_era, 2)), centurias), dia_anio);
+            const __m512i resultado = _mm512_add_epi32(_mm512_mullo_epi32(era, _mm512_set1_epi32(146097)), _mm512_sub_epi32(dias_era, _mm512_set1_epi32(719468)));
+            _mm512_storeu_si512(salida + i, resultado);
+        }
+        dias_escalar(anios + i, meses + i, dias + i, n - i, salida + i);
+    }
+
+#pragma GCC diagnostic pop
+
+#endif /* EDAD_SIMD_X86 */
+
+    using Nucleo = std::size_t(*)(const std::string_view*, std::size_t, std::int32_t*, std::int32_t*, std::int32_t*, std::uint8_t*) noexcept;
+    using NucleoDias = void(*)(const std::int32_t*, const std::int32_t*, const std::int32_t*, std::size_t, std::int32_t*) noexcept;
+
+    struct Variante {
+        const char* nombre;
+        Nucleo nucleo;
+        NucleoDias dias;
+    };
+
+    /// Elige la variante más ancha soportada por la CPU, salvo que `EDAD_SIMD` pida otra disponible.
+    Variante seleccionar_variante() noexcept {
+        const char* entorno = std::getenv("EDAD_SIMD");
+        const std::string_view pedida = entorno != nullptr ? entorno : "";
+        if (pedida == "escalar") {
+            return {"escalar", nucleo_escalar, dias_escalar};
+        }
+#ifdef EDAD_SIMD_X86
+        __builtin_cpu_init();
+        const bool avx512 = __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+        const bool avx2 = __builtin_cpu_supports("avx2");
+        const bool sse42 = __builtin_cpu_supports("sse4.2");
+        if (pedida == "sse4.2" && sse42) {
+            return {"sse4.2", nucleo_sse42, dias_sse42};
+        }
+        if (pedida == "avx2" && avx2) {
+            return {"avx2", nucleo_avx2, dias_avx2};
+        }
+        if (avx512) {
+            return {"avx512", nucleo_avx512, dias_avx512};
+        }
+        if (avx2) {
+            return {"avx2", nucleo_avx2, dias_avx2};
+        }
+        if (sse42) {
+            return {"sse4.2", nucleo_sse42, dias_sse42};
+        }
+#endif
+        return {"escalar", nucleo_escalar, dias_escalar};
+    }
+
+    const Variante& variante() noexcept {
+        static const Variante seleccionada = seleccionar_variante();
+        return seleccionada;
+    }
+}
+
+std::size_t edad::parsear_fechas_lote(const std::string_view* textos, std::size_t n,
+        std::int32_t* anios, std::int32_t* meses, std::int32_t* dias,
+        std::uint8_t* validas) noexcept {
+    return variante().nucleo(textos, n, anios, meses, dias, validas);
+}
+
+const char* edad::isa_fechas() noexcept {
+    return variante().nombre;
+}
+
+void edad::fechas_a_dias_lote(const std::int32_t* anios, const std::int32_t* meses, const std::int32_t* dias,
+        std::size_t n, std::int32_t* salida) noexcept {
+    variante().dias(anios, meses, dias, n, salida);
+}
@@ -0,0 +1,78 @@
+#ifndef FECHASIMD_H
+#define FECHASIMD_H
+
+/**
+ * @file FechaSimd.h
+ * @brief Parseo y validación vectorizada de lotes de fechas ISO "YYYY-MM-DD" con despacho en tiempo de ejecución.
+ *
+ * @details
+ * Cada fecha ocupa exactamente 10 bytes, por lo que cabe en un registro de 128 bits. El núcleo:
+ *   1. Copia cada fecha a una ranura de 16 bytes (sin leer más allá del texto original).
+ *   2. Resta '0' a todos los bytes y verifica con comparaciones SIMD que las 8 posiciones de dígitos
+ *      estén en [0..9] y que las posiciones 4 y 7 sean '-'.
+ *   3. Reordena los dígitos con `pshufb` y los combina con `pmaddubsw` + `pmaddwd`
+ *      (pares decimales y luego centenas) para obtener (año, mes, día) como enteros de 32 bits.
+ *   4. Transpone a estructura de arreglos (SoA) y valida mes ∈ [1..12] y día ∈ [1..días del mes]
+ *      (bisiestos mediante prueba de divisibilidad por multiplicación modular, sin divisiones).
+ *
+ * | ISA          | Fechas por registro | Fechas por iteración |
+ * |--------------|---------------------|----------------------|
+ * | SSE4.2       | 1 (parseo) / 4 (calendario) | 4  |
+ * | AVX2         | 2 / 8               | 8                    |
+ * | AVX-512BW    | 4 / 16              | 16                   |
+ *
+ * La ISA se elige **una vez en tiempo de ejecución** (`__builtin_cpu_supports`), de modo que un mismo
+ * binario compilado sin `-march=native` usa la mejor variante disponible en cada máquina. La variable de
+ * entorno `EDAD_SIMD` (`escalar`, `sse4.2`, `avx2`, `avx512`) fuerza una variante para comparar
+ * rendimiento o depurar; si la CPU no la soporta se ignora.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace edad {
+
+    /**
+     * @brief Parsea y valida en lote @p n fechas ISO, escribiendo el resultado en arreglos separados (SoA).
+     *
+     * @param textos Arreglo de @p n líneas; cada una debe contener exactamente "YYYY-MM-DD".
+     * @param n Cantidad de líneas.
+     * @param anios Destino de los años (@p n elementos).
+     * @param meses Destino de los meses (@p n elementos).
+     * @param dias Destino de los días (@p n elementos).
+     * @param validas Destino: 1 si la línea es una fecha válida, 0 en caso contrario (@p n elementos).
+     * @return Cantidad de líneas inválidas.
+     *
+     * @note Para las líneas inválidas el contenido de `anios[i]`, `meses[i]` y `dias[i]` no está especificado.
+     * @note Acepta exactamente las mismas líneas que @ref parsear_fecha(std::string_view, Fecha&).
+     */
+    std::size_t parsear_fechas_lote(const std::string_view* textos, std::size_t n,
+            std::int32_t* anios, std::int32_t* meses, std::int32_t* dias,
+            std::uint8_t* validas) noexcept;
+
+    /**
+     * @brief Versión en lote de @ref fecha_a_dias sobre arreglos separados (SoA), con aritmética entera SIMD.
+     *
+     * @param anios Años (@p n elementos).
+     * @param meses Meses en [1..12] (@p n elementos).
+     * @param dias Días en [1..31] (@p n elementos).
+     * @param n Cantidad de fechas.
+     * @param salida Destino: `salida[i] == fecha_a_dias(anios[i], meses[i], dias[i])` (@p n elementos).
+     *
+     * @details
+     * Las ramas del algoritmo de Hinnant (`mes <= 2` y era negativa) se expresan como mezclas con máscara,
+     * de modo que cada iteración convierte 4, 8 o 16 fechas sin saltos. Usa la misma variante SIMD que
+     * @ref parsear_fechas_lote. Los resultados son exactos para |año| < 5.000.000 (el número de días cabe en 32 bits).
+     * Para entradas fuera de rango (p. ej. de líneas inválidas) el resultado no está especificado.
+     */
+    void fechas_a_dias_lote(const std::int32_t* anios, const std::int32_t* meses, const std::int32_t* dias,
+            std::size_t n, std::int32_t* salida) noexcept;
+
+    /**
+     * @brief Nombre de la variante SIMD seleccionada para @ref parsear_fechas_lote y @ref fechas_a_dias_lote ("avx512", "avx2", "sse4.2" o "escalar").
+     */
+    const char* isa_fechas() noexcept;
+}
+
+#endif /* FECHASIMD_H */
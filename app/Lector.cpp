@@ -0,0 +1,157 @@
+#include "Lector.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+edad::ArchivoMapeado::ArchivoMapeado(const std::string& ruta, bool paginas_grandes) {
+    const int descriptor = ::open(ruta.c_str(), O_RDONLY | O_CLOEXEC);
+    if (descriptor < 0) {
+        throw std::system_error(errno, std::generic_category(), ruta);
+    }
+    struct stat estado {};
+    if (::fstat(descriptor, &estado) != 0) {
+        const int error = errno;
+        ::close(descriptor);
+        throw std::system_error(error, std::generic_category(), ruta);
+    }
+    if (!S_ISREG(estado.st_mode)) {
+        ::close(descriptor);
+        throw std::system_error(EINVAL, std::generic_category(), ruta + ": no es un archivo regular");
+    }
+
+    tamano_ = static_cast<std::size_t> (estado.st_size);
+    if (tamano_ > 0u) {
+        void* datos = ::mmap(nullptr, tamano_, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (datos == MAP_FAILED) {
+            const int error = errno;
+            ::close(descriptor);
+            throw std::system_error(error, std::generic_category(), ruta);
+        }
+        datos_ = datos;
+        // Sugerencias al kernel: su fallo no impide leer, así que se ignora.
+        ::madvise(datos_, tamano_, MADV_SEQUENTIAL);
+#ifdef MADV_HUGEPAGE
+        if (paginas_grandes) {
+            ::madvise(datos_, tamano_, MADV_HUGEPAGE);
+        }
+#else
+        (void) paginas_grandes;
+#endif
+    }
+    // La proyección sobrevive al cierre del descriptor.
+    ::close(descriptor);
+}
+
+edad::ArchivoMapeado::~ArchivoMapeado() {
+    if (datos_ != nullptr) {
+        ::munmap(datos_, tamano_);
+    }
+}
+
+std::string_view edad::ArchivoMapeado::contenido() const noexcept {
+    return std::string_view(static_cast<const char*> (datos_), tamano_);
+}
+
+void edad::ArchivoMapeado::liberar(std::string_view tramo) const noexcept {
+    if (datos_ == nullptr || tramo.empty()) {
+        return;
+    }
+    // Solo páginas completamente dentro del tramo: las de los bordes pueden seguir en uso por otro tramo.
+    const std::uintptr_t pagina = static_cast<std::uintptr_t> (::sysconf(_SC_PAGESIZE));
+    const std::uintptr_t inicio = (reinterpret_cast<std::uintptr_t> (tramo.data()) + pagina - 1u) / pagina * pagina;
+    const std::uintptr_t fin = (reinterpret_cast<std::uintptr_t> (tramo.data()) + tramo.size()) / pagina * pagina;
+    if (fin > inicio) {
+        // Sugerencia: si falla, las páginas simplemente siguen proyectadas.
+        ::madvise(reinterpret_cast<void*> (inicio), fin - inicio, MADV_DONTNEED);
+    }
+}
+
+void edad::ArchivoMapeado::precargar(std::string_view tramo) const noexcept {
+    if (datos_ == nullptr || tramo.empty()) {
+        return;
+    }
+    // Todas las páginas que el tramo toca, incluidas las de los bordes.
+    const std::uintptr_t pagina = static_cast<std::uintptr_t> (::sysconf(_SC_PAGESIZE));
+    const std::uintptr_t inicio = reinterpret_cast<std::uintptr_t> (tramo.data()) / pagina * pagina;
+    const std::uintptr_t fin = reinterpret_cast<std::uintptr_t> (tramo.data()) + tramo.size();
+    // Sugerencia: si falla, las páginas se leen en el primer acceso.
+    ::madvise(reinterpret_cast<void*> (inicio), fin - inicio, MADV_WILLNEED);
+}
+
+std::vector<std::string_view> edad::dividir_en_rangos(std::string_view texto, std::size_t partes) {
+    if (partes == 0u) {
+        partes = 1u;
+    }
+    std::vector<std::string_view> rangos;
+    rangos.reserve(partes);
+    std::size_t inicio = 0u;
+    for (std::size_t i = 1u; i <= partes && inicio < texto.size(); ++i) {
+        std::size_t fin = texto.size();
+        if (i < partes) {
+            // Corte nominal, desplazado hasta justo después del siguiente '\n'.
+            const std::size_t corte = std::max(inicio, texto.size() / partes * i);
+            const std::size_t salto = texto.find('\n', corte);
+            fin = salto == std::string_view::npos ? texto.size() : salto + 1u;
+        }
+        if (fin > inicio) {
+            rangos.push_back(texto.substr(inicio, fin - inicio));
+        }
+        inicio = fin;
+    }
+    return rangos;
+}
+
+std::string_view edad::siguiente_rango(std::string_view& resto, std::size_t bytes) noexcept {
+    std::size_t fin = resto.size();
+    if (bytes < resto.size()) {
+        const std::size_t salto = resto.find('\n', bytes == 0u ? 0u : bytes - 1u);
+        fin = salto == std::string_view::npos ? resto.size() : salto + 1u;
+    }
+    const std::string_view rango = resto.substr(0u, fin);
+    resto.remove_prefix(fin);
+    return rango;
+}
+
+std::string_view edad::lineas_en_rango(std::string_view texto, std::size_t desde, std::size_t hasta) noexcept {
+    // Inicio de la primera línea que empieza en 'posicion' o después.
+    const auto inicio_de_linea = [texto](std::size_t posicion) {
+        if (posicion == 0u || posicion >= texto.size()) {
+            return std::min(posicion, texto.size());
+        }
+        if (texto[posicion - 1u] == '\n') {
+            return posicion;
+        }
+        const std::size_t salto = texto.find('\n', posicion);
+        return salto == std::string_view::npos ? texto.size() : salto + 1u;
+    };
+    const std::size_t inicio = inicio_de_linea(desde);
+    const std::size_t fin = inicio_de_linea(hasta);
+    return fin > inicio ? texto.substr(inicio, fin - inicio) : std::string_view();
+}
+
+std::size_t edad::siguientes_lineas(std::string_view& resto, std::string_view* lineas, std::size_t maximo) noexcept {
+    const char* cursor = resto.data();
+    const char* const fin = cursor + resto.size();
+    std::size_t cantidad = 0u;
+    while (cantidad < maximo && cursor != fin) {
+        const char* salto = static_cast<const char*> (std::memchr(cursor, '\n', static_cast<std::size_t> (fin - cursor)));
+        if (salto == nullptr) {
+            // Última línea sin '\n' final (igual que std::getline).
+            lineas[cantidad++] = std::string_view(cursor, static_cast<std::size_t> (fin - cursor));
+            cursor = fin;
+        } else {
+            lineas[cantidad++] = std::string_view(cursor, static_cast<std::size_t> (salto - cursor));
+            cursor = salto + 1;
+        }
+    }
+    resto = std::string_view(cursor, static_cast<std::size_t> (fin - cursor));
+    return cantidad;
+}
@@ -0,0 +1,131 @@
+#ifndef LECTOR_H
+#define LECTOR_H
+
+/**
+ * @file Lector.h
+ * @brief Lectura del archivo de entrada mediante `mmap` y división en rangos alineados a líneas.
+ *
+ * @details
+ * En lugar de `std::ifstream` + `std::getline` en un solo hilo (una copia por línea y un único núcleo
+ * parseando), el archivo se proyecta en memoria una vez y se divide en rangos de bytes cuyos bordes caen
+ * justo después de un '\n'. Cada trabajador recorre su propio rango y entrega `std::string_view` a los
+ * núcleos en lote, sin copiar ni reservar memoria por línea; la lectura escala con los núcleos hasta el
+ * límite de la *page cache*.
+ *
+ * Solo se proyectan archivos regulares: las entradas no regulares (FIFO, `<(cat datos.csv)`, `/dev/stdin`) se
+ * leen en flujo con búferes acotados mediante @ref LectorXz (ver @ref es_flujo).
+ *
+ * Las líneas se separan igual que con `std::getline`: un '\n' final no produce una línea vacía extra y
+ * el '\r' de archivos CRLF se conserva (la línea resulta inválida para @ref parsear_fecha).
+ *
+ * @code{.cpp}
+ * const edad::ArchivoMapeado archivo("datos.csv");
+ * for (std::string_view rango : edad::dividir_en_rangos(archivo.contenido(), 8u)) {
+ *     std::string_view lineas[edad::LINEAS_POR_BLOQUE];
+ *     std::size_t cantidad;
+ *     while ((cantidad = edad::siguientes_lineas(rango, lineas, edad::LINEAS_POR_BLOQUE)) > 0u) {
+ *         // ... procesar lineas[0..cantidad)
+ *     }
+ * }
+ * @endcode
+ */
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace edad {
+
+    /**
+     * @brief Archivo proyectado en memoria (solo lectura) con propiedad RAII de la proyección.
+     */
+    class ArchivoMapeado {
+    public:
+        /**
+         * @brief Proyecta @p ruta completo en memoria.
+         *
+         * @param ruta Archivo regular a leer.
+         * @param paginas_grandes Si es `true`, sugiere al kernel páginas grandes (`MADV_HUGEPAGE`); solo
+         *        tiene efecto donde el kernel admite THP para la *page cache* del sistema de archivos.
+         * @throws std::system_error Si el archivo no se puede abrir, no es regular (ver @ref es_flujo) o no se
+         *         puede proyectar.
+         *
+         * @details Aplica `MADV_SEQUENTIAL` para que el kernel lea por adelantado de forma agresiva.
+         */
+        explicit ArchivoMapeado(const std::string& ruta, bool paginas_grandes = false);
+
+        ~ArchivoMapeado();
+
+        ArchivoMapeado(const ArchivoMapeado&) = delete;
+        ArchivoMapeado& operator=(const ArchivoMapeado&) = delete;
+
+        /// Contenido completo del archivo (vacío si el archivo no tiene bytes).
+        std::string_view contenido() const noexcept;
+
+        /**
+         * @brief Descarta de la proyección las páginas completas de @p tramo (parte de @ref contenido) ya procesado.
+         *
+         * @details `MADV_DONTNEED`: las páginas dejan de contar en el RSS del proceso (siguen en la *page cache*
+         *          y, si se vuelven a leer, se proyectan de nuevo con el mismo contenido). Las páginas que @p tramo
+         *          comparte en sus bordes con otros tramos se conservan. Liberar cada tramo tras procesarlo acota
+         *          el RSS a los tramos en curso, incluso con archivos de miles de millones de líneas.
+         */
+        void liberar(std::string_view tramo) const noexcept;
+
+        /**
+         * @brief Sugiere al kernel leer ya de disco las páginas de @p tramo (subcadena de @ref contenido).
+         *
+         * @details `MADV_WILLNEED`: inicia la lectura anticipada sin esperarla, así el primer acceso no se bloquea
+         *          en un fallo de página mayor. Útil cuando un hilo anticipa los tramos que otros van a recorrer.
+         */
+        void precargar(std::string_view tramo) const noexcept;
+
+    private:
+        void* datos_ = nullptr;
+        std::size_t tamano_ = 0u;
+    };
+
+    /**
+     * @brief Divide @p texto en a lo más @p partes rangos contiguos de tamaño similar, alineados a líneas.
+     *
+     * @param texto Texto completo (por ejemplo @ref ArchivoMapeado::contenido).
+     * @param partes Cantidad deseada de rangos (al menos 1).
+     * @return Rangos no vacíos que cubren @p texto en orden; cada uno, salvo quizás el último, termina en '\n'.
+     *
+     * @details Cada corte se desplaza hasta justo después del siguiente '\n', de modo que ninguna línea
+     *          queda partida entre dos rangos. Con líneas muy largas puede haber menos de @p partes rangos.
+     */
+    std::vector<std::string_view> dividir_en_rangos(std::string_view texto, std::size_t partes);
+
+    /**
+     * @brief Extrae del inicio de @p resto un rango de unos @p bytes que termina justo después de un '\n'.
+     *
+     * @return El rango (vacío si @p resto lo está); @p resto avanza tras él. El rango mide al menos
+     *         @p bytes salvo al final del texto, y más si la línea del corte nominal es larga.
+     * @details Versión incremental de @ref dividir_en_rangos con tamaño fijo: no requiere conocer de antemano
+     *          la cantidad de rangos ni guardarlos todos.
+     */
+    std::string_view siguiente_rango(std::string_view& resto, std::size_t bytes) noexcept;
+
+    /**
+     * @brief Líneas completas de @p texto cuyo primer byte está en [@p desde, @p hasta).
+     *
+     * @details Permite repartir un texto en rangos de bytes arbitrarios (p. ej. un `tbb::blocked_range` que se
+     *          subdivide a demanda): rangos de bytes disjuntos que cubren el texto dan rangos de líneas disjuntos
+     *          que también lo cubren, sin que ningún rango conozca los cortes de los demás.
+     */
+    std::string_view lineas_en_rango(std::string_view texto, std::size_t desde, std::size_t hasta) noexcept;
+
+    /**
+     * @brief Extrae hasta @p maximo líneas del inicio de @p resto y avanza @p resto tras ellas.
+     *
+     * @param resto Texto pendiente; al retornar apunta a la primera línea no extraída.
+     * @param lineas Destino de las líneas, sin el '\n' final (@p maximo elementos).
+     * @param maximo Máximo de líneas a extraer.
+     * @return Cantidad de líneas extraídas (0 si @p resto está vacío).
+     */
+    std::size_t siguientes_lineas(std::string_view& resto, std::string_view* lineas, std::size_t maximo) noexcept;
+}
+
+#endif /* LECTOR_H */
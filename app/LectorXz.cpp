@@ -0,0 +1,475 @@
+#include "LectorXz.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+    /// Bytes comprimidos leídos de una vez de una entrada no regular.
+    constexpr std::size_t TRAMO_ENTRADA = std::size_t{1} << 20;
+
+    /// Indica si @p ruta existe y es un archivo regular.
+    bool es_regular(const std::string& ruta) {
+        struct stat estado {};
+        return ::stat(ruta.c_str(), &estado) == 0 && S_ISREG(estado.st_mode);
+    }
+
+    /// Cabecera de un stream .xz.
+    constexpr unsigned char MAGIA_XZ[] = {0xFD, '7', 'z', 'X', 'Z', 0x00};
+
+    /// Descripción legible de un código de error de liblzma.
+    const char* descripcion_lzma(lzma_ret codigo) noexcept {
+        switch (codigo) {
+            case LZMA_MEM_ERROR: return "memoria insuficiente";
+            case LZMA_MEMLIMIT_ERROR: return "límite de memoria alcanzado";
+            case LZMA_FORMAT_ERROR: return "no es un archivo .xz";
+            case LZMA_OPTIONS_ERROR: return "opciones de compresión no soportadas";
+            case LZMA_DATA_ERROR: return "datos comprimidos corruptos";
+            case LZMA_BUF_ERROR: return "archivo .xz truncado";
+            default: return "error interno de liblzma";
+        }
+    }
+}
+
+bool edad::es_xz(const std::string& ruta) {
+    if (ruta.size() >= 3u && ruta.compare(ruta.size() - 3u, 3u, ".xz") == 0) {
+        return true;
+    }
+    // En un FIFO o /dev/stdin leer la cabecera la consumiría (y el búfer de ifstream, unos KiB más): solo extensión.
+    if (!es_regular(ruta)) {
+        return false;
+    }
+    std::ifstream archivo(ruta, std::ios::binary);
+    char cabecera[sizeof (MAGIA_XZ)] = {};
+    return archivo.read(cabecera, sizeof (cabecera)) && std::memcmp(cabecera, MAGIA_XZ, sizeof (MAGIA_XZ)) == 0;
+}
+
+bool edad::es_flujo(const std::string& ruta) {
+    return !es_regular(ruta) || es_xz(ruta);
+}
+
+edad::LectorXz::LectorXz(const std::string& ruta, std::size_t buferes, std::size_t tamano_bufer, std::size_t hilos)
+: tamano_bufer_(tamano_bufer) {
+    if (es_regular(ruta)) {
+        comprimido_.emplace(ruta);
+    } else {
+        // No se puede proyectar: se lee en streaming, sin retener más que un tramo de entrada.
+        descriptor_ = ::open(ruta.c_str(), O_RDONLY | O_CLOEXEC);
+        if (descriptor_ < 0) {
+            throw std::system_error(errno, std::generic_category(), ruta);
+        }
+    }
+    texto_ = !es_xz(ruta);
+    hilos = std::max<std::size_t>(hilos, 1u);
+    if (hilos > 1u && comprimido_ && !texto_) {
+        leer_indice();
+    }
+    if (bloques_.empty()) {
+        const lzma_ret codigo = texto_ ? LZMA_OK : lzma_stream_decoder(&flujo_, UINT64_MAX, LZMA_CONCATENATED);
+        if (codigo != LZMA_OK) {
+            if (descriptor_ >= 0) {
+                ::close(descriptor_);
+            }
+            throw std::runtime_error(ruta + ": " + descripcion_lzma(codigo));
+        }
+        hilos = 1u;
+    } else {
+        hilos = std::min(hilos, bloques_.size());
+        bloques_pendientes_ = bloques_.size();
+        cabezas_.resize(bloques_.size());
+        colas_.resize(bloques_.size());
+        decodificados_.assign(bloques_.size(), 0u);
+    }
+
+    // Cada hilo descompresor retiene un búfer mientras decodifica: quedan al menos dos para los trabajadores.
+    buferes = std::max(buferes, hilos + 2u);
+    for (std::size_t i = 0u; i < buferes; ++i) {
+        // Por bloques, cada búfer se reserva al tamaño del bloque la primera vez que se usa.
+        buferes_.emplace_back(bloques_.empty() ? new char[tamano_bufer_] : nullptr);
+        capacidades_.push_back(bloques_.empty() ? tamano_bufer_ : 0u);
+        libres_.push_back(i);
+    }
+    inicios_.assign(buferes, 0u);
+    longitudes_.assign(buferes, 0u);
+
+    for (std::size_t i = 0u; i < hilos; ++i) {
+        hilos_.emplace_back(bloques_.empty() ? &LectorXz::descomprimir : &LectorXz::descomprimir_bloques, this);
+    }
+}
+
+edad::LectorXz::~LectorXz() {
+    {
+        std::lock_guard<std::mutex> candado(mutex_);
+        cancelado_ = true;
+    }
+    hay_libre_.notify_all();
+    for (std::thread& hilo : hilos_) {
+        hilo.join();
+    }
+    lzma_end(&flujo_);
+    if (descriptor_ >= 0) {
+        ::close(descriptor_);
+    }
+}
+
+bool edad::LectorXz::tomar(TrozoXz& trozo) {
+    std::unique_lock<std::mutex> candado(mutex_);
+    hay_lleno_.wait(candado, [this] {
+        return !llenos_.empty() || terminado_;
+    });
+    if (llenos_.empty()) {
+        return false;
+    }
+    trozo.indice = llenos_.front();
+    llenos_.pop_front();
+    if (trozo.indice == buferes_.size()) {
+        // Índice reservado: las líneas de borde entre bloques.
+        trozo.texto = fragmentos_;
+    } else {
+        trozo.texto = std::string_view(buferes_[trozo.indice].get() + inicios_[trozo.indice], longitudes_[trozo.indice]);
+    }
+    return true;
+}
+
+void edad::LectorXz::devolver(const TrozoXz& trozo) {
+    if (trozo.indice == buferes_.size()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> candado(mutex_);
+        libres_.push_back(trozo.indice);
+    }
+    hay_libre_.notify_one();
+}
+
+std::size_t edad::LectorXz::buferes() const noexcept {
+    return buferes_.size();
+}
+
+std::size_t edad::LectorXz::bloques() const noexcept {
+    return bloques_.size();
+}
+
+std::string edad::LectorXz::error() const {
+    std::lock_guard<std::mutex> candado(mutex_);
+    return error_;
+}
+
+void edad::LectorXz::leer_indice() {
+    const std::string_view entrada = comprimido_->contenido();
+    lzma_stream flujo = LZMA_STREAM_INIT;
+    lzma_index* indice = nullptr;
+    if (lzma_file_info_decoder(&flujo, &indice, UINT64_MAX, entrada.size()) != LZMA_OK) {
+        return;
+    }
+    // El decodificador pide saltos (LZMA_SEEK_NEEDED) para leer solo pies de stream e índices.
+    flujo.next_in = reinterpret_cast<const std::uint8_t*> (entrada.data());
+    flujo.avail_in = entrada.size();
+    lzma_ret codigo;
+    while ((codigo = lzma_code(&flujo, LZMA_RUN)) == LZMA_OK || codigo == LZMA_SEEK_NEEDED) {
+        if (codigo == LZMA_SEEK_NEEDED) {
+            if (flujo.seek_pos > entrada.size()) {
+                break;
+            }
+            flujo.next_in = reinterpret_cast<const std::uint8_t*> (entrada.data()) + flujo.seek_pos;
+            flujo.avail_in = entrada.size() - static_cast<std::size_t> (flujo.seek_pos);
+        }
+    }
+    lzma_end(&flujo);
+    if (codigo != LZMA_STREAM_END) {
+        return;
+    }
+
+    if (lzma_index_block_count(indice) > 1u) {
+        lzma_index_iter iterador;
+        lzma_index_iter_init(&iterador, indice);
+        while (!lzma_index_iter_next(&iterador, LZMA_INDEX_ITER_NONEMPTY_BLOCK)) {
+            bloques_.push_back(Bloque{
+                static_cast<std::size_t> (iterador.block.compressed_file_offset),
+                static_cast<std::size_t> (iterador.block.unpadded_size),
+                static_cast<std::size_t> (iterador.block.uncompressed_size),
+                iterador.stream.flags != nullptr ? iterador.stream.flags->check : LZMA_CHECK_NONE});
+        }
+    }
+    lzma_index_end(indice, nullptr);
+}
+
+bool edad::LectorXz::tomar_libre(std::size_t capacidad, std::size_t& indice) {
+    {
+        std::unique_lock<std::mutex> candado(mutex_);
+        hay_libre_.wait(candado, [this] {
+            return !libres_.empty() || cancelado_;
+        });
+        if (cancelado_) {
+            return false;
+        }
+        indice = libres_.front();
+        libres_.pop_front();
+    }
+    if (capacidades_[indice] < capacidad) {
+        // El búfer pertenece a este hilo hasta publicarlo: se puede reemplazar sin candado.
+        buferes_[indice].reset(new char[capacidad]);
+        capacidades_[indice] = capacidad;
+    }
+    return true;
+}
+
+void edad::LectorXz::publicar(std::size_t indice, std::size_t inicio, std::size_t longitud) {
+    {
+        std::lock_guard<std::mutex> candado(mutex_);
+        inicios_[indice] = inicio;
+        longitudes_[indice] = longitud;
+        if (longitud > 0u) {
+            llenos_.push_back(indice);
+        } else {
+            libres_.push_back(indice);
+        }
+    }
+    if (longitud > 0u) {
+        hay_lleno_.notify_one();
+    } else {
+        hay_libre_.notify_one();
+    }
+}
+
+long edad::LectorXz::leer_entrada(std::uint8_t* destino, std::size_t capacidad, std::string& error) {
+    for (;;) {
+        const ssize_t leidos = ::read(descriptor_, destino, capacidad);
+        if (leidos >= 0) {
+            return static_cast<long> (leidos);
+        }
+        if (errno != EINTR) {
+            error = std::strerror(errno);
+            return -1;
+        }
+    }
+}
+
+void edad::LectorXz::descomprimir() {
+    // Entrada: la proyección completa o, si no es un archivo regular, tramos de TRAMO_ENTRADA leídos a medida que
+    // el decodificador los consume (el texto sin comprimir se lee directo a los búferes del anillo).
+    std::vector<std::uint8_t> entrada(comprimido_ || texto_ ? 0u : TRAMO_ENTRADA);
+    bool entrada_agotada = comprimido_.has_value();
+    std::size_t bytes_entrada = 0u;
+    if (comprimido_) {
+        const std::string_view proyeccion = comprimido_->contenido();
+        flujo_.next_in = reinterpret_cast<const std::uint8_t*> (proyeccion.data());
+        flujo_.avail_in = proyeccion.size();
+        bytes_entrada = proyeccion.size();
+    }
+
+    // Tramo final (línea incompleta) del búfer anterior, a copiar al inicio del siguiente.
+    std::vector<char> arrastre;
+    std::string error;
+    bool fin = false;
+
+    while (!fin) {
+        std::size_t indice;
+        if (!tomar_libre(tamano_bufer_, indice)) {
+            break;
+        }
+
+        char* bufer = buferes_[indice].get();
+        std::memcpy(bufer, arrastre.data(), arrastre.size());
+        flujo_.next_out = reinterpret_cast<std::uint8_t*> (bufer + arrastre.size());
+        flujo_.avail_out = tamano_bufer_ - arrastre.size();
+
+        while (flujo_.avail_out > 0u) {
+            if (flujo_.avail_in == 0u && !entrada_agotada) {
+                std::uint8_t* const destino = texto_ ? flujo_.next_out : entrada.data();
+                const long leidos = leer_entrada(destino, texto_ ? flujo_.avail_out : entrada.size(), error);
+                if (leidos < 0) {
+                    fin = true;
+                    break;
+                }
+                bytes_entrada += static_cast<std::size_t> (leidos);
+                entrada_agotada = leidos == 0;
+                if (texto_) {
+                    flujo_.next_out += leidos;
+                    flujo_.avail_out -= static_cast<std::size_t> (leidos);
+                    continue;
+                }
+                flujo_.next_in = entrada.data();
+                flujo_.avail_in = static_cast<std::size_t> (leidos);
+            }
+            if (texto_) {
+                // Sin comprimir: se copia lo que queda de la proyección.
+                const std::size_t copia = std::min<std::size_t>(flujo_.avail_in, flujo_.avail_out);
+                std::memcpy(flujo_.next_out, flujo_.next_in, copia);
+                flujo_.next_in += copia;
+                flujo_.avail_in -= copia;
+                flujo_.next_out += copia;
+                flujo_.avail_out -= copia;
+                if (flujo_.avail_in == 0u) {
+                    fin = true;
+                    break;
+                }
+                continue;
+            }
+            // Con toda la entrada disponible (proyección o último tramo leído), LZMA_FINISH.
+            const lzma_ret codigo = lzma_code(&flujo_, entrada_agotada ? LZMA_FINISH : LZMA_RUN);
+            if (codigo == LZMA_STREAM_END) {
+                fin = true;
+                break;
+            }
+            if (codigo != LZMA_OK) {
+                error = bytes_entrada == 0u ? "archivo .xz vacío" : descripcion_lzma(codigo);
+                fin = true;
+                break;
+            }
+        }
+
+        const std::size_t usados = tamano_bufer_ - flujo_.avail_out;
+        std::size_t longitud = usados;
+        arrastre.clear();
+        if (!fin) {
+            // Entregar solo líneas completas; lo posterior al último '\n' pasa al siguiente búfer.
+            const char* ultimo = static_cast<const char*> (memrchr(bufer, '\n', usados));
+            if (ultimo != nullptr) {
+                longitud = static_cast<std::size_t> (ultimo - bufer) + 1u;
+                arrastre.assign(bufer + longitud, bufer + usados);
+            }
+        }
+        publicar(indice, 0u, longitud);
+    }
+
+    {
+        std::lock_guard<std::mutex> candado(mutex_);
+        terminado_ = true;
+        error_ = error;
+    }
+    hay_lleno_.notify_all();
+}
+
+std::string edad::LectorXz::decodificar_bloque(const Bloque& bloque, char* destino) const {
+    const std::uint8_t* entrada = reinterpret_cast<const std::uint8_t*> (comprimido_->contenido().data());
+    const std::size_t fin_bloque = bloque.desplazamiento + bloque.tamano_sin_relleno;
+    if (fin_bloque > comprimido_->contenido().size()) {
+        return descripcion_lzma(LZMA_BUF_ERROR);
+    }
+
+    lzma_filter filtros[LZMA_FILTERS_MAX + 1];
+    lzma_block cabecera{};
+    cabecera.version = 0;
+    cabecera.check = bloque.check;
+    cabecera.filters = filtros;
+    cabecera.header_size = lzma_block_header_size_decode(entrada[bloque.desplazamiento]);
+
+    lzma_ret codigo = lzma_block_header_decode(&cabecera, nullptr, entrada + bloque.desplazamiento);
+    if (codigo != LZMA_OK) {
+        return descripcion_lzma(codigo);
+    }
+    codigo = lzma_block_compressed_size(&cabecera, bloque.tamano_sin_relleno);
+    if (codigo == LZMA_OK) {
+        std::size_t posicion_entrada = bloque.desplazamiento + cabecera.header_size;
+        std::size_t posicion_salida = 0u;
+        // El relleno del bloque (hasta múltiplo de 4) también forma parte de la entrada.
+        const std::size_t fin_entrada = std::min(comprimido_->contenido().size(), (fin_bloque + 3u) & ~std::size_t{3});
+        codigo = lzma_block_buffer_decode(&cabecera, nullptr, entrada, &posicion_entrada, fin_entrada,
+                reinterpret_cast<std::uint8_t*> (destino), &posicion_salida, bloque.tamano_descomprimido);
+        if (codigo == LZMA_OK && posicion_salida != bloque.tamano_descomprimido) {
+            codigo = LZMA_DATA_ERROR;
+        }
+    }
+    for (std::size_t i = 0u; filtros[i].id != LZMA_VLI_UNKNOWN; ++i) {
+        std::free(filtros[i].options);
+    }
+    return codigo == LZMA_OK ? std::string() : std::string(descripcion_lzma(codigo));
+}
+
+void edad::LectorXz::descomprimir_bloques() {
+    for (;;) {
+        std::size_t numero;
+        {
+            std::lock_guard<std::mutex> candado(mutex_);
+            if (siguiente_bloque_ == bloques_.size() || cancelado_) {
+                return;
+            }
+            numero = siguiente_bloque_++;
+        }
+        const Bloque& bloque = bloques_[numero];
+
+        std::size_t indice;
+        if (!tomar_libre(bloque.tamano_descomprimido, indice)) {
+            return;
+        }
+        char* bufer = buferes_[indice].get();
+        const std::string error = decodificar_bloque(bloque, bufer);
+
+        // Solo líneas completas: el borde inicial (salvo en el primer bloque) y el final se guardan aparte.
+        std::size_t inicio = 0u;
+        std::size_t fin = error.empty() ? bloque.tamano_descomprimido : 0u;
+        const char* ultimo = static_cast<const char*> (memrchr(bufer, '\n', fin));
+        if (ultimo == nullptr) {
+            cabezas_[numero].assign(bufer, fin);
+            fin = 0u;
+        } else {
+            if (numero > 0u) {
+                inicio = static_cast<std::size_t> (static_cast<const char*> (std::memchr(bufer, '\n', fin)) - bufer) + 1u;
+                cabezas_[numero].assign(bufer, inicio);
+            }
+            colas_[numero].assign(ultimo + 1, static_cast<std::size_t> (bufer + fin - (ultimo + 1)));
+            fin = static_cast<std::size_t> (ultimo - bufer) + 1u;
+        }
+        decodificados_[numero] = error.empty() ? 1u : 0u;
+        publicar(indice, inicio, fin > inicio ? fin - inicio : 0u);
+
+        bool ultimo_bloque;
+        {
+            std::lock_guard<std::mutex> candado(mutex_);
+            if (!error.empty()) {
+                // Se conserva el primer error y no se decodifican más bloques.
+                if (error_.empty()) {
+                    error_ = error;
+                }
+                bloques_pendientes_ -= bloques_.size() - siguiente_bloque_;
+                siguiente_bloque_ = bloques_.size();
+            }
+            ultimo_bloque = --bloques_pendientes_ == 0u;
+        }
+        if (ultimo_bloque) {
+            // Todos los bloques listos: reconstruir las líneas de borde en orden y entregarlas al final. Una línea
+            // que toca un bloque fallido (o no decodificado tras el error) se descarta entera: unir la cola del
+            // bloque anterior con la cabeza del siguiente fabricaría una línea que no está en el archivo.
+            std::string linea;
+            bool valida = true;
+            for (std::size_t i = 0u; i < bloques_.size(); ++i) {
+                if (decodificados_[i] == 0u) {
+                    linea.clear();
+                    valida = false;
+                    continue;
+                }
+                linea += cabezas_[i];
+                // Sin '\n' en el bloque, la cabeza es el bloque completo y la línea sigue en el próximo.
+                if (cabezas_[i].empty() || cabezas_[i].back() == '\n') {
+                    if (valida) {
+                        fragmentos_ += linea;
+                    }
+                    linea = colas_[i];
+                    valida = true;
+                }
+            }
+            if (valida) {
+                fragmentos_ += linea;
+            }
+            {
+                std::lock_guard<std::mutex> candado(mutex_);
+                if (!fragmentos_.empty()) {
+                    llenos_.push_back(buferes_.size());
+                }
+                terminado_ = true;
+            }
+            hay_lleno_.notify_all();
+            return;
+        }
+    }
+}
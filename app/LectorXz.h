@@ -0,0 +1,198 @@
+#ifndef LECTORXZ_H
+#define LECTORXZ_H
+
+/**
+ * @file LectorXz.h
+ * @brief Lectura de archivos `.xz` con liblzma, con descompresión solapada con el parseo y, si el archivo
+ *        tiene varios bloques, repartida entre varios hilos.
+ *
+ * @details
+ * Evita tener que ejecutar `xz -d` a disco antes de procesar (doble E/S y doble espacio). Un hilo
+ * descompresor llena un anillo de búferes grandes; los trabajadores toman búferes llenos, los recorren
+ * sin copiar (con @ref siguientes_lineas) y los devuelven para que se vuelvan a llenar.
+ *
+ * Cada búfer entregado contiene solo **líneas completas**: al llenarse, el tramo posterior al último '\n'
+ * se arrastra al inicio del siguiente búfer, de modo que ninguna línea queda partida entre dos búferes.
+ * Solo el último búfer puede terminar sin '\n' (igual que con `std::getline`). Una línea más larga que un
+ * búfer completo se entrega partida (resulta inválida en cualquier caso).
+ *
+ * ### Varios bloques
+ * Un `.xz` con varios bloques (p. ej. `xz -T0`, o reescrito con `recomprimir`) tiene un índice con la
+ * posición y el tamaño de cada bloque, y los bloques se decodifican de forma independiente. Con más de un
+ * hilo de descompresión, cada hilo toma el siguiente bloque, lo decodifica completo en un búfer del anillo y
+ * lo entrega apenas termina (sin esperar a los bloques anteriores). Como los bordes de bloque pueden caer a
+ * mitad de línea, de cada bloque se entregan solo sus líneas completas y los fragmentos de borde (antes del
+ * primer '\n' y después del último) se guardan aparte; al terminar todos los bloques, los fragmentos se
+ * concatenan en orden y se entregan como un último trozo. Si el archivo no tiene índice legible o tiene un
+ * solo bloque, se usa la descompresión en streaming con un hilo.
+ *
+ * ### Entradas no regulares
+ * Un FIFO, una sustitución de procesos (`<(zcat datos.csv.gz)`) o `/dev/stdin` no se pueden proyectar ni
+ * recorrer dos veces. Se leen con `read()` de a tramos acotados, en streaming con un hilo: si la ruta termina en
+ * `.xz` se descomprime, y si no, el texto pasa tal cual a los búferes (mismo arrastre de la línea incompleta).
+ * La memoria queda acotada a los búferes del anillo, sin importar el tamaño de la entrada. @ref es_flujo indica
+ * qué entradas deben leerse con este lector en lugar de @ref ArchivoMapeado.
+ *
+ * @code{.cpp}
+ * edad::LectorXz lector("edades.csv.xz");
+ * edad::TrozoXz trozo;
+ * while (lector.tomar(trozo)) {
+ *     // ... procesar trozo.texto (líneas completas)
+ *     lector.devolver(trozo);
+ * }
+ * if (!lector.error().empty()) { ... }
+ * @endcode
+ */
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <lzma.h>
+
+#include "Lector.h"
+
+namespace edad {
+
+    /**
+     * @brief Indica si @p ruta es un archivo `.xz` (extensión o *magic bytes* `FD 37 7A 58 5A 00`).
+     * @details Los *magic bytes* solo se miran en archivos regulares: en una entrada no regular (FIFO, `/dev/stdin`)
+     *          leerlos los quitaría de la entrada, así que se decide solo por la extensión.
+     */
+    bool es_xz(const std::string& ruta);
+
+    /**
+     * @brief Indica si @p ruta debe leerse en flujo con @ref LectorXz: un `.xz` o una entrada que no es un archivo
+     *        regular (no se puede proyectar). También si @p ruta no existe, para que el error lo informe el lector.
+     */
+    bool es_flujo(const std::string& ruta);
+
+    /**
+     * @brief Búfer de líneas completas entregado por @ref LectorXz::tomar.
+     */
+    struct TrozoXz {
+        std::string_view texto; ///< Líneas completas descomprimidas (válidas hasta @ref LectorXz::devolver).
+        std::size_t indice = 0u; ///< Búfer del anillo al que pertenece.
+    };
+
+    /**
+     * @brief Descompresor `.xz` en uno o más hilos propios que produce búferes de líneas completas (también lee
+     *        sin descomprimir una entrada no regular de texto; ver LectorXz.h).
+     *
+     * @details
+     * @ref tomar y @ref devolver son thread-safe: varios trabajadores pueden consumir a la vez. Un trabajador
+     * debe devolver cada trozo tomado; si retiene todos los búferes sin devolverlos, el descompresor se detiene.
+     */
+    class LectorXz {
+    public:
+        /**
+         * @brief Abre @p ruta e inicia el o los hilos descompresores.
+         *
+         * @param ruta Archivo `.xz` (uno o más *streams* concatenados), o entrada no regular (`.xz` o texto).
+         * @param buferes Cantidad de búferes del anillo (al menos 2).
+         * @param tamano_bufer Bytes por búfer en streaming (con varios bloques, cada búfer toma el tamaño del bloque).
+         * @param hilos Hilos de descompresión; con más de uno y un archivo de varios bloques, se decodifican
+         *        bloques en paralelo.
+         * @throws std::system_error Si el archivo no se puede abrir o proyectar.
+         * @throws std::runtime_error Si liblzma no puede inicializar el decodificador.
+         */
+        explicit LectorXz(const std::string& ruta, std::size_t buferes = 4u, std::size_t tamano_bufer = std::size_t{4} << 20,
+                std::size_t hilos = 1u);
+
+        /// Detiene el descompresor (si sigue activo) y espera su término.
+        ~LectorXz();
+
+        LectorXz(const LectorXz&) = delete;
+        LectorXz& operator=(const LectorXz&) = delete;
+
+        /**
+         * @brief Espera el siguiente búfer lleno.
+         * @return `false` cuando ya no quedan búferes (fin del archivo o error; ver @ref error).
+         */
+        bool tomar(TrozoXz& trozo);
+
+        /// Devuelve al anillo un trozo obtenido con @ref tomar.
+        void devolver(const TrozoXz& trozo);
+
+        /// Cantidad de búferes del anillo.
+        std::size_t buferes() const noexcept;
+
+        /// Cantidad de bloques que se decodifican en paralelo (0 si se usa descompresión en streaming).
+        std::size_t bloques() const noexcept;
+
+        /// Descripción del error de descompresión (vacía si no hubo error). Válida tras el último @ref tomar.
+        std::string error() const;
+
+    private:
+        /// Ubicación de un bloque según el índice del archivo.
+        struct Bloque {
+            std::size_t desplazamiento; ///< Inicio de la cabecera del bloque en el archivo comprimido.
+            std::size_t tamano_sin_relleno; ///< *Unpadded size* (cabecera + datos + check).
+            std::size_t tamano_descomprimido;
+            lzma_check check;
+        };
+
+        /// Lee el índice; deja @ref bloques_ vacío si no se puede o hay un solo bloque.
+        void leer_indice();
+
+        /// Cuerpo del hilo descompresor en streaming.
+        void descomprimir();
+
+        /**
+         * @brief Lee del descriptor de una entrada no regular hasta @p capacidad bytes en @p destino.
+         * @return Bytes leídos (0 al final de la entrada), o -1 con @p error descrito.
+         */
+        long leer_entrada(std::uint8_t* destino, std::size_t capacidad, std::string& error);
+
+        /// Cuerpo de cada hilo descompresor por bloques.
+        void descomprimir_bloques();
+
+        /// Decodifica el bloque @p bloque en @p destino; retorna la descripción del error o una cadena vacía.
+        std::string decodificar_bloque(const Bloque& bloque, char* destino) const;
+
+        /// Espera un búfer libre con al menos @p capacidad bytes; retorna `false` si se canceló.
+        bool tomar_libre(std::size_t capacidad, std::size_t& indice);
+
+        /// Publica @p longitud bytes del búfer @p indice desde @p inicio (o lo devuelve a libres si está vacío).
+        void publicar(std::size_t indice, std::size_t inicio, std::size_t longitud);
+
+        std::optional<ArchivoMapeado> comprimido_; ///< Proyección de un archivo regular.
+        int descriptor_ = -1; ///< Entrada no regular, leída en streaming (si no hay proyección).
+        bool texto_ = false; ///< Entrada no regular sin comprimir: se copia sin pasar por liblzma.
+        lzma_stream flujo_ = LZMA_STREAM_INIT;
+        std::size_t tamano_bufer_;
+        std::vector<std::unique_ptr<char[]>> buferes_;
+        std::vector<std::size_t> capacidades_;
+        std::vector<std::size_t> inicios_;
+        std::vector<std::size_t> longitudes_;
+
+        std::vector<Bloque> bloques_;
+        std::size_t siguiente_bloque_ = 0u; ///< Protegido por @ref mutex_.
+        std::size_t bloques_pendientes_ = 0u; ///< Protegido por @ref mutex_.
+        std::vector<std::string> cabezas_; ///< Texto hasta el primer '\n' inclusive (o el bloque completo si no tiene '\n').
+        std::vector<std::string> colas_; ///< Texto después del último '\n'.
+        std::vector<unsigned char> decodificados_; ///< 1 si el bloque se decodificó sin error.
+        std::string fragmentos_; ///< Líneas de borde reconstruidas, entregadas al final.
+
+        mutable std::mutex mutex_;
+        std::condition_variable hay_libre_;
+        std::condition_variable hay_lleno_;
+        std::deque<std::size_t> libres_;
+        std::deque<std::size_t> llenos_;
+        bool terminado_ = false;
+        bool cancelado_ = false;
+        std::string error_;
+
+        std::vector<std::thread> hilos_;
+    };
+}
+
+#endif /* LECTORXZ_H */
@@ -0,0 +1,64 @@
+#include "Lote.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Edad.h"
+#include "Lector.h"
+
+edad::Lote::Lote(std::size_t capacidad) : capacidad_(std::max<std::size_t>(capacidad, 1u)) {
+    inicios_.reserve(capacidad_);
+    longitudes_.reserve(capacidad_);
+}
+
+void edad::Lote::limpiar() noexcept {
+    texto_.clear();
+    inicios_.clear();
+    longitudes_.clear();
+}
+
+void edad::Lote::redimensionar(std::size_t capacidad) {
+    capacidad_ = std::max<std::size_t>(capacidad, 1u);
+    inicios_.reserve(capacidad_);
+    longitudes_.reserve(capacidad_);
+}
+
+std::size_t edad::Lote::llenar(std::string_view& resto) {
+    std::string_view lineas[LINEAS_POR_BLOQUE];
+    std::size_t agregadas = 0u;
+    while (!lleno() && !resto.empty()) {
+        const char* const inicio = resto.data();
+        const std::size_t cantidad = siguientes_lineas(resto, lineas, std::min(LINEAS_POR_BLOQUE, capacidad_ - inicios_.size()));
+
+        // Las líneas extraídas son contiguas en el origen: un solo memcpy para todo el tramo.
+        const std::size_t base = texto_.size();
+        const std::size_t bytes = static_cast<std::size_t> (resto.data() - inicio);
+        texto_.resize(base + bytes);
+        std::memcpy(texto_.data() + base, inicio, bytes);
+        for (std::size_t k = 0u; k < cantidad; ++k) {
+            inicios_.push_back(static_cast<std::uint32_t> (base + static_cast<std::size_t> (lineas[k].data() - inicio)));
+            longitudes_.push_back(static_cast<std::uint32_t> (lineas[k].size()));
+        }
+        agregadas += cantidad;
+    }
+    return agregadas;
+}
+
+std::size_t edad::Lote::lineas() const noexcept {
+    return inicios_.size();
+}
+
+std::size_t edad::Lote::capacidad() const noexcept {
+    return capacidad_;
+}
+
+bool edad::Lote::lleno() const noexcept {
+    return inicios_.size() >= capacidad_;
+}
+
+void edad::Lote::vistas(std::size_t desde, std::size_t n, std::string_view* destino) const noexcept {
+    const char* const texto = texto_.data();
+    for (std::size_t k = 0u; k < n; ++k) {
+        destino[k] = std::string_view(texto + inicios_[desde + k], longitudes_[desde + k]);
+    }
+}
@@ -0,0 +1,69 @@
+#ifndef LOTE_H
+#define LOTE_H
+
+/**
+ * @file Lote.h
+ * @brief Unidad de trabajo del pipeline productor–consumidor: un bloque de líneas en un búfer reciclable.
+ *
+ * @details
+ * Encolar un `std::string*` por línea cuesta una reserva, una liberación y dos CAS sobre la cola compartida
+ * por cada línea (≈10 M de cada una en edades.csv). Un @ref Lote agrupa miles de líneas: el productor copia
+ * el tramo contiguo de texto que las contiene con un solo `memcpy` y registra dónde empieza y cuánto mide
+ * cada línea; la cola transporta un puntero por lote. Los lotes se reciclan (el consumidor los devuelve a
+ * una lista libre y el productor los vuelve a llenar), así que tras el arranque no hay memoria dinámica
+ * por línea ni por lote.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace edad {
+
+    /**
+     * @brief Bloque de hasta @ref capacidad líneas copiadas en un búfer propio, con sus desplazamientos.
+     *
+     * @details No es thread-safe: pertenece a un solo hilo a la vez (productor mientras lo llena,
+     *          consumidor mientras lo procesa); la cola establece el *happens-before* entre ambos.
+     */
+    class Lote {
+    public:
+        /// Lote vacío para hasta @p capacidad líneas (al menos 1).
+        explicit Lote(std::size_t capacidad);
+
+        /// Vacía el lote conservando la memoria reservada.
+        void limpiar() noexcept;
+
+        /// Cambia a @p capacidad (al menos 1) las líneas del lote vacío; reserva memoria solo si supera lo ya reservado.
+        void redimensionar(std::size_t capacidad);
+
+        /**
+         * @brief Copia al lote líneas del inicio de @p resto hasta llenarlo, y avanza @p resto tras ellas.
+         * @return Cantidad de líneas agregadas (0 si el lote está lleno o @p resto vacío).
+         * @details Las líneas se separan como en @ref siguientes_lineas; el tramo copiado es contiguo en
+         *          @p resto, así que se copia con un único `memcpy` por llamada.
+         */
+        std::size_t llenar(std::string_view& resto);
+
+        /// Cantidad de líneas del lote.
+        std::size_t lineas() const noexcept;
+
+        /// Máximo de líneas del lote.
+        std::size_t capacidad() const noexcept;
+
+        /// `true` si el lote alcanzó su capacidad.
+        bool lleno() const noexcept;
+
+        /// Escribe en @p destino las vistas de las líneas [@p desde, @p desde + @p n) (válidas mientras no se modifique el lote).
+        void vistas(std::size_t desde, std::size_t n, std::string_view* destino) const noexcept;
+
+    private:
+        std::size_t capacidad_;
+        std::vector<char> texto_;
+        std::vector<std::uint32_t> inicios_;
+        std::vector<std::uint32_t> longitudes_;
+    };
+}
+
+#endif /* LOTE_H */
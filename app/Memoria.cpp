@@ -0,0 +1,140 @@
+#include "Memoria.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <new>
+
+namespace {
+
+    /// Franjas de contadores; los hilos se reparten entre ellas por orden de llegada.
+    constexpr std::size_t FRANJAS = 64u;
+
+    /// Contadores de una franja, en su propia línea de caché.
+    struct alignas(64) Franja {
+        std::atomic<std::uint64_t> reservas{0u};
+        std::atomic<std::uint64_t> liberaciones{0u};
+        std::atomic<std::uint64_t> bytes{0u};
+    };
+
+    Franja franjas[FRANJAS];
+    std::atomic<std::size_t> siguiente_franja{0u};
+
+    /// Franja del hilo actual (se asigna en su primera reserva o liberación).
+    Franja& franja_propia() noexcept {
+        thread_local Franja& propia = franjas[siguiente_franja.fetch_add(1u, std::memory_order_relaxed) % FRANJAS];
+        return propia;
+    }
+
+    /// Cuenta una reserva de @p bytes y retorna @p puntero.
+    void* contar_reserva(void* puntero, std::size_t bytes) noexcept {
+        if (puntero != nullptr) {
+            Franja& franja = franja_propia();
+            franja.reservas.fetch_add(1u, std::memory_order_relaxed);
+            franja.bytes.fetch_add(bytes, std::memory_order_relaxed);
+        }
+        return puntero;
+    }
+
+    /// Cuenta la liberación de @p puntero (si no es nulo).
+    void contar_liberacion(void* puntero) noexcept {
+        if (puntero != nullptr) {
+            franja_propia().liberaciones.fetch_add(1u, std::memory_order_relaxed);
+        }
+    }
+
+    /// Reserva como el `operator new` estándar: reintenta con el `new_handler` y lanza `std::bad_alloc` si no hay.
+    void* reservar(std::size_t bytes, std::size_t alineacion) {
+        if (bytes == 0u) {
+            bytes = 1u;
+        }
+        for (;;) {
+            void* const puntero = alineacion <= __STDCPP_DEFAULT_NEW_ALIGNMENT__
+                    ? std::malloc(bytes)
+                    : std::aligned_alloc(alineacion, (bytes + alineacion - 1u) / alineacion * alineacion);
+            if (puntero != nullptr) {
+                return contar_reserva(puntero, bytes);
+            }
+            const std::new_handler manejador = std::get_new_handler();
+            if (manejador == nullptr) {
+                throw std::bad_alloc();
+            }
+            manejador();
+        }
+    }
+}
+
+// Se reemplazan también las formas de arreglo (no todas las bibliotecas las delegan en las simples); las nothrow
+// de libstdc++ delegan en estas.
+
+void* operator new(std::size_t bytes) {
+    return reservar(bytes, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* operator new(std::size_t bytes, std::align_val_t alineacion) {
+    return reservar(bytes, static_cast<std::size_t> (alineacion));
+}
+
+void* operator new[](std::size_t bytes) {
+    return reservar(bytes, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* operator new[](std::size_t bytes, std::align_val_t alineacion) {
+    return reservar(bytes, static_cast<std::size_t> (alineacion));
+}
+
+void operator delete(void* puntero) noexcept {
+    contar_liberacion(puntero);
+    std::free(puntero);
+}
+
+void operator delete(void* puntero, std::align_val_t) noexcept {
+    contar_liberacion(puntero);
+    std::free(puntero);
+}
+
+void operator delete(void* puntero, std::size_t) noexcept {
+    operator delete(puntero);
+}
+
+void operator delete(void* puntero, std::size_t, std::align_val_t alineacion) noexcept {
+    operator delete(puntero, alineacion);
+}
+
+void operator delete[](void* puntero) noexcept {
+    operator delete(puntero);
+}
+
+void operator delete[](void* puntero, std::align_val_t alineacion) noexcept {
+    operator delete(puntero, alineacion);
+}
+
+void operator delete[](void* puntero, std::size_t) noexcept {
+    operator delete(puntero);
+}
+
+void operator delete[](void* puntero, std::size_t, std::align_val_t alineacion) noexcept {
+    operator delete(puntero, alineacion);
+}
+
+edad::ContadoresMemoria edad::contadores_memoria() noexcept {
+    ContadoresMemoria total;
+    for (const Franja& franja : franjas) {
+        total.reservas += franja.reservas.load(std::memory_order_relaxed);
+        total.liberaciones += franja.liberaciones.load(std::memory_order_relaxed);
+        total.bytes += franja.bytes.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void edad::imprimir_memoria(const ContadoresMemoria& antes, const ContadoresMemoria& despues, std::ostream& salida,
+        const char* etapa) {
+    const std::ios::fmtflags banderas = salida.flags();
+    const std::streamsize precision = salida.precision();
+    salida << "Memoria dinámica " << etapa << ": " << despues.reservas - antes.reservas << " reservas ("
+            << std::fixed << std::setprecision(1) << static_cast<double> (despues.bytes - antes.bytes) / (1024.0 * 1024.0)
+            << " MiB), " << despues.liberaciones - antes.liberaciones << " liberaciones\n";
+    salida.flags(banderas);
+    salida.precision(precision);
+}
@@ -0,0 +1,48 @@
+#ifndef MEMORIA_H
+#define MEMORIA_H
+
+/**
+ * @file Memoria.h
+ * @brief Contadores de memoria dinámica del programa (reservas y liberaciones por `operator new`/`delete`).
+ *
+ * @details
+ * Memoria.cpp reemplaza los `operator new` y `operator delete` globales por versiones sobre `malloc`/`free` que
+ * además cuentan cada llamada. Así `--metricas-memoria` informa cuántas reservas hizo un motor durante el conteo
+ * (p. ej. una por línea con `new std::string`, ninguna por línea con `edad::ArenaLineas`). Un motor que reserva de
+ * antemano sus estructuras (colas, lotes, arena) puede anotar en `Resultado` los contadores al terminar de crearlas
+ * y antes de destruirlas; entonces se informan por separado la preparación, el régimen y el cierre. Los contadores se
+ * reparten en franjas por hilo para que contar no agregue contención entre hilos que reservan a la vez.
+ *
+ * @code{.cpp}
+ * const edad::ContadoresMemoria antes = edad::contadores_memoria();
+ * ...
+ * edad::imprimir_memoria(antes, edad::contadores_memoria(), std::cerr);
+ * @endcode
+ *
+ * @note Solo se cuenta lo que pasa por `operator new` (contenedores, `std::string`, `new`); las reservas directas
+ *       con `malloc` de bibliotecas en C (liblzma) no.
+ */
+
+#include <cstdint>
+#include <ostream>
+
+namespace edad {
+
+    /**
+     * @brief Totales acumulados desde el inicio del programa.
+     */
+    struct ContadoresMemoria {
+        std::uint64_t reservas = 0u; ///< Llamadas a `operator new` (todas sus formas).
+        std::uint64_t liberaciones = 0u; ///< Llamadas a `operator delete` con un puntero no nulo.
+        std::uint64_t bytes = 0u; ///< Bytes pedidos en total a `operator new`.
+    };
+
+    /// Totales hasta ahora, sumando todos los hilos (las llamadas en curso en otros hilos pueden no verse).
+    ContadoresMemoria contadores_memoria() noexcept;
+
+    /// Informa en @p salida las reservas, liberaciones y bytes entre @p antes y @p despues, rotulados con @p etapa.
+    void imprimir_memoria(const ContadoresMemoria& antes, const ContadoresMemoria& despues, std::ostream& salida,
+            const char* etapa = "del conteo");
+}
+
+#endif /* MEMORIA_H */
@@ -0,0 +1,108 @@
+#include "Motor.h"
+
+#include <iostream>
+
+#include "Memoria.h"
+
+edad::Resultado::Resultado(const std::vector<Calculadora>& calculadoras, bool por_fechas) {
+    if (por_fechas) {
+        conteo.emplace(calculadoras);
+    }
+}
+
+edad::Acumulador::Acumulador(const std::vector<Calculadora>& calculadoras, bool por_fechas)
+: calculadora_(&calculadoras.front()) {
+    if (por_fechas) {
+        conteo_.emplace(calculadoras);
+    }
+}
+
+void edad::Acumulador::procesar(const std::string_view* lineas, std::size_t n) {
+    procesar(lineas, n, [this](int clave) {
+        ++histograma_[static_cast<std::size_t> (clave)];
+    });
+}
+
+void edad::Acumulador::procesar_rango(std::string_view rango) {
+    procesar_rango(rango, [this](int clave) {
+        ++histograma_[static_cast<std::size_t> (clave)];
+    });
+}
+
+void edad::Acumulador::combinar(const Acumulador& otro) {
+    if (conteo_) {
+        conteo_->combinar(*otro.conteo_);
+        return;
+    }
+    sumar_histograma(histograma_, otro.histograma_);
+    invalidas_ += otro.invalidas_;
+    fuera_rango_ += otro.fuera_rango_;
+}
+
+void edad::Acumulador::volcar(Resultado& resultado) const {
+    if (conteo_) {
+        resultado.conteo->combinar(*conteo_);
+        return;
+    }
+    sumar_histograma(resultado.histograma, histograma_);
+    resultado.invalidas += invalidas_;
+    resultado.fuera_rango += fuera_rango_;
+}
+
+edad::Resultado edad::contar(const Opciones& opciones, const std::vector<Calculadora>& calculadoras) {
+    Resultado resultado(calculadoras, opciones.agregacion == ModoAgregacion::fechas);
+    const ContadoresMemoria memoria = contadores_memoria();
+    switch (opciones.motor) {
+        case Motor::serial:
+            contar_serial(opciones, calculadoras, resultado);
+            break;
+        case Motor::tareas:
+            contar_tareas(opciones, calculadoras, resultado);
+            break;
+        case Motor::cola:
+            contar_cola(opciones, calculadoras, resultado);
+            break;
+        case Motor::bloques:
+            contar_bloques(opciones, calculadoras, resultado);
+            break;
+        case Motor::tbb:
+            contar_tbb(opciones, calculadoras, resultado);
+            break;
+        case Motor::std_par:
+            contar_std_par(opciones, calculadoras, resultado);
+            break;
+        case Motor::numa:
+            contar_numa(opciones, calculadoras, resultado);
+            break;
+        case Motor::corrutinas:
+            contar_corrutinas(opciones, calculadoras, resultado);
+            break;
+    }
+    if (opciones.metricas_memoria) {
+        const ContadoresMemoria despues = contadores_memoria();
+        if (resultado.memoria_preparada && resultado.memoria_regimen) {
+            imprimir_memoria(memoria, *resultado.memoria_preparada, std::cerr, "de la preparación");
+            imprimir_memoria(*resultado.memoria_preparada, *resultado.memoria_regimen, std::cerr, "del régimen");
+            imprimir_memoria(*resultado.memoria_regimen, despues, std::cerr, "del cierre");
+        } else {
+            imprimir_memoria(memoria, despues, std::cerr);
+        }
+    }
+    return resultado;
+}
+
+bool edad::emitir_resultado(const Resultado& resultado, const Opciones& opciones, const std::vector<Calculadora>& calculadoras,
+        std::ostream& salida, std::ostream& resumen) {
+    if (!resultado.error.empty()) {
+        resumen << resultado.error << "\n";
+    }
+    if (resultado.conteo) {
+        // Fase 2: convertir a edad una vez por fecha distinta, con un histograma por fecha de referencia.
+        imprimir_por_referencia(*resultado.conteo, calculadoras, salida, resumen);
+        return opciones.ruta_conteo_fechas.empty() || escribir_conteo_fechas(*resultado.conteo, opciones.ruta_conteo_fechas);
+    }
+    imprimir_histograma(resultado.histograma, salida);
+    // Resumen de descartes por stderr: no altera el histograma emitido en stdout.
+    imprimir_descartes(resultado.invalidas, resultado.fuera_rango, resumen);
+    return true;
+}
@@ -0,0 +1,185 @@
+#ifndef MOTOR_H
+#define MOTOR_H
+
+/**
+ * @file Motor.h
+ * @brief Motores de ejecución intercambiables (`--motor=`) y las piezas que comparten.
+ *
+ * @details
+ * Todos los motores leen con los mismos lectores (`edad::ArchivoMapeado`, `edad::LectorXz`), clasifican con la
+ * misma `edad::Calculadora` a través de un @ref edad::Acumulador por hilo y entregan un @ref edad::Resultado que se
+ * emite siempre con @ref edad::emitir_resultado. Lo único que cambia entre motores es cómo se reparte el texto
+ * entre hilos y dónde se acumula; como el histograma es una suma de enteros, la salida es idéntica byte a byte
+ * en todos (y en todos los modos de `--histograma` que admiten).
+ *
+ * | `--motor=` | Reparto | Archivo | Ver |
+ * |------------|---------|---------|-----|
+ * | `serial`   | un solo hilo, sin OpenMP | MotorSerial.cpp | referencia de corrección y de aceleración |
+ * | `tareas`   | un hilo `single` crea OpenMP tasks por rango de `--tarea-kib` | MotorTareas.cpp | |
+ * | `cola`     | lectores + cola lock-free de lotes (`--lectores`, `--consumidores`, `--cola`, `--lote`, `--espera`) | MotorCola.cpp | por omisión |
+ * | `bloques`  | `omp for schedule(dynamic)` sobre bloques de `--tarea-kib` | MotorBloques.cpp | |
+ * | `tbb`      | `tbb::parallel_for` con robo de trabajo; `parallel_pipeline` para `.xz` | MotorTbb.cpp | |
+ * | `std-par`  | `std::transform_reduce(std::execution::par, ...)` sobre rangos de líneas | MotorStdPar.cpp | solo biblioteca estándar |
+ * | `numa`     | hilos fijados; una porción del archivo y un acumulador por nodo NUMA | MotorNuma.cpp | equipos de varios zócalos |
+ * | `corrutinas` | etapas de C++20 (lectura → análisis → agregación) con canales acotados | MotorCorrutinas.cpp | ver Corrutinas.h |
+ *
+ * Todos los motores usan `OMP_NUM_THREADS` (o la cantidad de núcleos) como cantidad de hilos.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Agregacion.h"
+#include "Edad.h"
+#include "Lector.h"
+#include "Memoria.h"
+#include "Opciones.h"
+
+namespace edad {
+
+    /**
+     * @brief Lo que produce un motor: histograma (o conteo por fecha), descartes y el error de lectura, si hubo.
+     */
+    struct Resultado {
+        /// Crea un resultado vacío; con agregación `fechas`, con un conteo cuya ventana cubre @p calculadoras.
+        Resultado(const std::vector<Calculadora>& calculadoras, bool por_fechas);
+
+        /// Ocurrencias por edad (agregación `edades`).
+        Histograma histograma{};
+
+        /// Líneas con fecha inválida (incluye vacías) y con edad fuera de [0, @ref EDAD_MAXIMA] (agregación `edades`).
+        std::uint64_t invalidas = 0u;
+        std::uint64_t fuera_rango = 0u;
+
+        /// Conteo por fecha combinado (solo con agregación `fechas`).
+        std::optional<ConteoFechas> conteo;
+
+        /// Mensaje de error de apertura o lectura (vacío si no hubo); lo que se haya leído se emite igual.
+        std::string error;
+
+        /// Contadores de memoria (ver Memoria.h) tras crear las estructuras del motor, antes de leer la primera
+        /// línea, y tras la última línea, antes de destruirlas; solo si el motor los anota (con
+        /// `--metricas-memoria`). Separan la preparación y el cierre del régimen.
+        std::optional<ContadoresMemoria> memoria_preparada;
+        std::optional<ContadoresMemoria> memoria_regimen;
+    };
+
+    /**
+     * @brief Estado de clasificación de un hilo: histograma y descartes propios, o conteo por fecha propio.
+     *
+     * @details No es thread-safe: uno por hilo (o por tarea) y @ref volcar al final, o @ref combinar de a pares
+     *          (la combinación es asociativa y conmutativa, apta para una reducción paralela).
+     */
+    class Acumulador {
+    public:
+        /// @p calculadoras debe sobrevivir al acumulador (se clasifica con la primera).
+        Acumulador(const std::vector<Calculadora>& calculadoras, bool por_fechas);
+
+        /**
+         * @brief Clasifica @p n líneas (a lo sumo @ref LINEAS_POR_BLOQUE) y llama a @p sumar(clave) por cada edad
+         *        válida; los descartes se cuentan aquí. Con agregación `fechas` solo cuenta por fecha.
+         * @details Permite acumular en otra estructura (atómicos compartidos, mapa, copia de una reducción).
+         */
+        template <typename Sumar>
+        void procesar(const std::string_view* lineas, std::size_t n, Sumar&& sumar);
+
+        /// Clasifica @p n líneas (a lo sumo @ref LINEAS_POR_BLOQUE) en el histograma propio.
+        void procesar(const std::string_view* lineas, std::size_t n);
+
+        /// Clasifica todas las líneas de @p rango en bloques de @ref LINEAS_POR_BLOQUE, con @p sumar como en @ref procesar.
+        template <typename Sumar>
+        void procesar_rango(std::string_view rango, Sumar&& sumar);
+
+        /// Clasifica todas las líneas de @p rango en el histograma propio.
+        void procesar_rango(std::string_view rango);
+
+        /// Suma a este acumulador lo acumulado en @p otro (creado con las mismas calculadoras y agregación).
+        void combinar(const Acumulador& otro);
+
+        /// Suma lo acumulado a @p resultado (quien llama sincroniza si varios hilos vuelcan a la vez).
+        void volcar(Resultado& resultado) const;
+
+    private:
+        const Calculadora* calculadora_;
+        Histograma histograma_{};
+        std::uint64_t invalidas_ = 0u;
+        std::uint64_t fuera_rango_ = 0u;
+        std::optional<ConteoFechas> conteo_;
+        std::int16_t claves_[LINEAS_POR_BLOQUE];
+    };
+
+    /// Un hilo, sin OpenMP (MotorSerial.cpp).
+    void contar_serial(const Opciones& opciones, const std::vector<Calculadora>& calculadoras, Resultado& resultado);
+
+    /// OpenMP tasks creadas por un hilo `single` (MotorTareas.cpp).
+    void contar_tareas(const Opciones& opciones, const std::vector<Calculadora>& calculadoras, Resultado& resultado);
+
+    /// Lectores y cola lock-free de lotes o líneas hacia los consumidores (MotorCola.cpp).
+    void contar_cola(const Opciones& opciones, const std::vector<Calculadora>& calculadoras, Resultado& resultado);
+
+    /// `omp for` dinámico sobre bloques del archivo (MotorBloques.cpp).
+    void contar_bloques(const Opciones& opciones, const std::vector<Calculadora>& calculadoras, Resultado& resultado);
+
+    /// oneTBB con robo de trabajo (MotorTbb.cpp).
+    void contar_tbb(const Opciones& opciones, const std::vector<Calculadora>& calculadoras, Resultado& resultado);
+
+    /// Algoritmos paralelos de C++17: `std::transform_reduce` (MotorStdPar.cpp).
+    void contar_std_par(const Opciones& opciones, const std::vector<Calculadora>& calculadoras, Resultado& resultado);
+
+    /// Hilos fijados a núcleos y porciones por nodo NUMA (MotorNuma.cpp).
+    void contar_numa(const Opciones& opciones, const std::vector<Calculadora>& calculadoras, Resultado& resultado);
+
+    /// Pipeline de corrutinas por etapa sobre un grupo de hilos (MotorCorrutinas.cpp).
+    void contar_corrutinas(const Opciones& opciones, const std::vector<Calculadora>& calculadoras, Resultado& resultado);
+
+    /**
+     * @brief Ejecuta el motor de `opciones.motor` sobre `opciones.ruta`.
+     * @param calculadoras Una por fecha de referencia, en el orden de `opciones.referencias`.
+     */
+    Resultado contar(const Opciones& opciones, const std::vector<Calculadora>& calculadoras);
+
+    /**
+     * @brief Emite @p resultado: histograma(s) por @p salida, error y descartes por @p resumen y, si se pidió,
+     *        el conteo por fecha en `opciones.ruta_conteo_fechas`. Común a todos los motores.
+     * @return `false` si no se pudo escribir el conteo por fecha.
+     */
+    bool emitir_resultado(const Resultado& resultado, const Opciones& opciones, const std::vector<Calculadora>& calculadoras,
+            std::ostream& salida, std::ostream& resumen);
+}
+
+template <typename Sumar>
+void edad::Acumulador::procesar(const std::string_view* lineas, std::size_t n, Sumar&& sumar) {
+    if (conteo_) {
+        // Fase 1 de la agregación por fecha: solo días por fecha; la edad se calcula al emitir.
+        conteo_->contar_lote(lineas, n);
+        return;
+    }
+    // Contrato de la calculadora: const, thread-safe y no lanza.
+    calculadora_->clasificar_lote(lineas, n, claves_);
+    for (std::size_t k = 0u; k < n; ++k) {
+        const int clave = claves_[k];
+        if (clave == CLAVE_INVALIDA) {
+            ++invalidas_;
+        } else if (clave == CLAVE_FUERA_RANGO) {
+            ++fuera_rango_;
+        } else {
+            sumar(clave);
+        }
+    }
+}
+
+template <typename Sumar>
+void edad::Acumulador::procesar_rango(std::string_view rango, Sumar&& sumar) {
+    std::string_view lineas[LINEAS_POR_BLOQUE];
+    std::size_t cantidad;
+    while ((cantidad = siguientes_lineas(rango, lineas, LINEAS_POR_BLOQUE)) > 0u) {
+        procesar(lineas, cantidad, sumar);
+    }
+}
+
+#endif /* MOTOR_H */
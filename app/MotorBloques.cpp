@@ -0,0 +1,77 @@
+/**
+ * @file
+ * @brief Motor `bloques`: `#pragma omp for schedule(dynamic)` sobre bloques de tamaño fijo del archivo.
+ *
+ * La forma más directa de paralelizar con OpenMP: el archivo proyectado se ve como `ceil(tamaño / bloque)`
+ * iteraciones de `--tarea-kib` KiB, y cada iteración clasifica las líneas que **empiezan** en su bloque de bytes
+ * (`edad::lineas_en_rango`), así ningún bloque necesita conocer los cortes de los demás. Con `schedule(dynamic)`
+ * cada hilo toma el siguiente bloque libre al terminar el suyo (un incremento atómico por bloque), sin hilo
+ * productor ni cola. Cada hilo acumula en su propio `edad::Acumulador` y lo vuelca una vez al final.
+ *
+ * Un `.xz` no se puede indexar por bytes de texto: cada hilo toma directamente del `edad::LectorXz` el siguiente
+ * búfer de líneas completas (`tomar` y `devolver` son thread-safe), que hace las veces de bloque dinámico.
+ *
+ * @par Ejecución (ejemplos)
+ * @code{.bash}
+ * OMP_NUM_THREADS=8 ./paralelo --motor=bloques datos.csv
+ * OMP_NUM_THREADS=8 ./paralelo --motor=bloques --tarea-kib=256 datos.csv   # bloques más finos
+ * @endcode
+ *
+ * @see edad::contar_bloques
+ */
+
+#include "Motor.h"
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <omp.h>
+
+#include "LectorXz.h"
+
+void edad::contar_bloques(const Opciones& opciones, const std::vector<Calculadora>& calculadoras, Resultado& resultado) {
+    const std::string ruta = opciones.ruta;
+    const bool por_fechas = opciones.agregacion == ModoAgregacion::fechas;
+    const std::size_t hilos = static_cast<std::size_t> (omp_get_max_threads());
+    try {
+        if (es_flujo(ruta)) {
+            // Un búfer por hilo más dos, como en los demás motores.
+            LectorXz lector(ruta, hilos + 2u, std::size_t{4} << 20, hilos);
+#pragma omp parallel
+            {
+                Acumulador acumulador(calculadoras, por_fechas);
+                TrozoXz trozo;
+                while (lector.tomar(trozo)) {
+                    acumulador.procesar_rango(trozo.texto);
+                    lector.devolver(trozo);
+                }
+#pragma omp critical(resultado)
+                acumulador.volcar(resultado);
+            }
+            if (!lector.error().empty()) {
+                resultado.error = "No se pudo leer el archivo: " + ruta + ": " + lector.error();
+            }
+        } else {
+            const ArchivoMapeado archivo(ruta, opciones.paginas_grandes);
+            const std::string_view texto = archivo.contenido();
+            const std::size_t bytes = opciones.kib_por_tarea * 1024u;
+            const std::size_t bloques = (texto.size() + bytes - 1u) / bytes;
+#pragma omp parallel
+            {
+                Acumulador acumulador(calculadoras, por_fechas);
+#pragma omp for schedule(dynamic) nowait
+                for (std::size_t bloque = 0u; bloque < bloques; ++bloque) {
+                    const std::string_view rango = lineas_en_rango(texto, bloque * bytes, (bloque + 1u) * bytes);
+                    acumulador.procesar_rango(rango);
+                    archivo.liberar(rango);
+                }
+#pragma omp critical(resultado)
+                acumulador.volcar(resultado);
+            }
+        }
+    } catch (const std::runtime_error& error) {
+        resultado.error = std::string("No se pudo abrir el archivo: ") + error.what();
+    }
+}
@@ -0,0 +1,573 @@
+/**
+ * @file
+ * @brief Motor `cola`: pipeline productor–consumidor con OpenMP y cola lock-free (MPMC) para histogramar edades.
+ *
+ * @details
+ * ### Propósito
+ * Este motor (`--motor=cola`, el de omisión) implementa un pipeline concurrente orientado a throughput:
+ * - **Lectores** (`--lectores=N`, por omisión uno): hilos productores que toman rangos alineados a '\n' del archivo
+ *   texto/CSV proyectado en memoria (`edad::ArchivoMapeado`), separan sus líneas, las copian por tramos a lotes
+ *   reciclables (`edad::Lote`, `--lote=N` líneas cada uno) y encolan un puntero por lote en una estructura lock-free
+ *   (por omisión **MPMC** `boost::lockfree::queue`; `--cola=` elige otra implementación, ver Cola.h y
+ *   `bench_colas`). Si la entrada es `.xz` la descomprime en streaming (`edad::LectorXz`, hilo descompresor
+ *   propio) sin pasar por disco, y cada lector toma el siguiente búfer descomprimido.
+ * - **Consumidores** (`--consumidores=M`, por omisión el resto de `OMP_NUM_THREADS`; también los lectores al
+ *   terminar de leer) que extraen lotes, los recorren en bloques de
+ *   `edad::LINEAS_POR_BLOQUE`, los clasifican con `edad::Calculadora::clasificar_lote` (parseo y conversión a días
+ *   vectorizados; discretización por truncamiento en años enteros) y suman en su `edad::Acumulador` (histograma denso
+ *   de 131 contadores), que se vuelca una sola vez al final. `--histograma=mapa` agrega en cambio en un
+ *   `boost::unordered::concurrent_flat_map<int,int>` compartido (claves no acotadas; dos búsquedas y un bloqueo por línea).
+ * - Con `--agregacion=fechas` los consumidores solo cuentan ocurrencias por fecha en el `edad::ConteoFechas` de su acumulador;
+ *   ni el histograma ni la clasificación en edades participan por línea (ver Agregacion.h).
+ *
+ * ### Fundamentación técnica
+ * - **Lock-free vs wait-free:** `boost::lockfree::queue` provee *progreso lock-free* (al menos un hilo progresa bajo contención);
+ *   no es *wait-free* (no garantiza progreso en pasos finitos para cada hilo). La espera adaptativa (giro, yield y
+ *   estacionamiento; ver Espera.h) atenúa la contención sin ocupar núcleos cuando no hay trabajo.
+ * - **Tipo trivial (T)**: para ser elegible en `lockfree::queue<T>`, `T` debe ser *trivially copyable*; por eso se encolan
+ *   **punteros crudos** (`edad::Lote*`) y no los lotes mismos.
+ * - **Lotes reciclados**: los consumidores devuelven cada lote procesado a una segunda cola de lotes libres, de la que
+ *   los lectores los vuelven a llenar. Con miles de líneas por lote, el tráfico atómico sobre las colas y el uso del
+ *   *allocator* dejan de ser por línea; la cantidad fija de lotes acota además la memoria en vuelo. `--lote=0`
+ *   conserva el esquema histórico (un elemento de la cola por línea) para comparar.
+ * - **Arena de líneas** (`--lote=0`): cada línea se copia a una losa reciclable de `edad::ArenaLineas` en lugar de
+ *   un `std::string` en heap, que el lector reservaba y un consumidor liberaba (≈10 M reservas y liberaciones
+ *   cruzadas entre hilos). Los consumidores devuelven las líneas por bloques y las losas vacías vuelven a los
+ *   lectores: tras el arranque no hay `malloc`/`free` por línea (`--metricas-memoria` lo muestra en la línea de régimen).
+ * - **Marcas de agua y autoajuste**: con `--marca-alta`, el lector deja de llenar lotes cuando hay esa cantidad
+ *   esperando en la cola y consume él mismo hasta bajar a `--marca-baja`. `--autoajuste` ajusta el tamaño de lote
+ *   y las marcas durante la ejecución según lo que observa (ver Autoajuste.h) e informa el ajuste final.
+ * - **Linealizabilidad:** `push`/`pop` son operaciones atómicas linealizables; el mapa `concurrent_flat_map` expone
+ *   métodos `try_emplace/visit` que aseguran exclusión por clave durante la mutación del valor.
+ * - **Modelo de memoria:** usamos `std::memory_order_release/acquire` para el *flag* `terminado`, que da el último lector
+ *   en terminar (un contador `acq_rel` encadena a los anteriores). Esto establece un *happens-before* entre el
+ *   `store(release)` y el correspondiente `load(acquire)` del consumidor, garantizando visibilidad de la finalización. Los histogramas por hilo no necesitan atómicos: se combinan en una sección crítica al salir
+ *   del bucle de consumo, y la barrera implícita al final de la región los publica al hilo que imprime.
+ *
+ * ### Complejidad
+ * - Lectura y encolado: **O(N)** en número de líneas (latencia amortizada de `push` lock-free).
+ * - Procesamiento: **O(N)**; cada línea es un incremento en un arreglo propio del hilo; la combinación final es
+ *   **O(P·131)** para P hilos. Con `--histograma=mapa`, **O(1) amortizado** por línea, dependiente de colisiones/buckets
+ *   y de la política de `concurrent_flat_map`.
+ *
+ * ### Escalabilidad y performance
+ * - **Lectores**: con la página en caché o un NVMe rápido, un solo lector (copiar líneas a lotes) limita el caudal
+ *   antes que los consumidores; `--lectores=N` reparte esa copia. Las colas MPMC admiten varios productores sin
+ *   cambios; los anillos crean un anillo por par (lector, consumidor).
+ * - **Contención**: con `--histograma=mapa`, los *hot keys* (edades frecuentes, p.ej., 18–40) concentran accesos y
+ *   elevan la latencia en `visit`; por eso por omisión cada hilo cuenta en su propio arreglo y se combina al final.
+ * - **NUMA**: el lector único deja los lotes en la memoria de su nodo; en varios zócalos, `--motor=numa` fija los hilos
+ *   y reparte una porción del archivo por nodo para evitar los *remote misses* (ver MotorNuma.cpp).
+ * - **False sharing**: evitado en la cola (controlada por Boost); cada histograma por hilo vive en la pila de su hilo.
+ * - **Truncamiento**: `static_cast<int>(edad)` introduce **sesgo hacia abajo** frente a *floor* con negativos; como solo se aceptan
+ *   edades >= 0, el sesgo es el del truncamiento puro (ver @ref Discretizacion).
+ *
+ * ### Ejecución
+ * @code{.bash}
+ * OMP_NUM_THREADS=8 ./paralelo datos.csv
+ * OMP_NUM_THREADS=8 ./paralelo --lote=0 datos.csv   # una línea por elemento de la cola (esquema histórico)
+ * OMP_NUM_THREADS=8 ./paralelo --histograma=mapa datos.csv   # agregación en el mapa concurrente compartido
+ * OMP_NUM_THREADS=8 ./paralelo --cola=anillos-robo datos.csv   # anillos SPSC por consumidor con robo de trabajo
+ * OMP_NUM_THREADS=8 ./paralelo --espera=ceder --metricas-espera datos.csv   # tiempo de espera por hilo
+ * ./paralelo --lectores=2 --consumidores=6 datos.csv   # dos lectores y seis consumidores (8 hilos)
+ * OMP_NUM_THREADS=64 ./paralelo --autoajuste datos.csv   # informa el --lote y las --marca-* a fijar en este equipo
+ * @endcode
+ *
+ * @section ContratoEdad Contrato con `Edad.h`
+ * Se espera una API *thread-safe*. Una única `edad::Calculadora` (inmutable) se comparte entre todos los
+ * consumidores: la fecha de referencia se resuelve una sola vez, evitando consultar `std::time`/`localtime_r`
+ * por línea (punto de serialización oculto en glibc).
+ * @code
+ * namespace edad {
+ *   class Calculadora {
+ *   public:
+ *     void clasificar_lote(const std::string_view* fechas, std::size_t n, std::int16_t* claves) const noexcept;
+ *   };
+ * }
+ * @endcode
+ *
+ * @section FormatoEntrada Formato de entrada típico
+ * Línea con fecha interpretable por `edad::parsear_fecha`, p.ej. CSV:
+ * @code
+ * 2004-11-01
+ * 2005-01-06
+ * @endcode
+ *
+ *
+ * @section Glosario Glosario breve
+ * - **MPMC**: Multi-Producer Multi-Consumer. Aquí, uno o varios lectores y varios consumidores.
+ * - **Linealizabilidad**: cada operación concurrente aparenta ocurrir en un instante atómico total.
+ * - **Lock-free**: el sistema progresa aunque hilos individuales se bloqueen o fallen.
+ * - **Wait-free**: cada operación finaliza en pasos finitos (no garantizado aquí).
+ */
+
+#include "Motor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <boost/lockfree/queue.hpp>
+#include <chrono>
+#include <limits>
+#include <boost/unordered/concurrent_flat_map.hpp>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <omp.h>
+
+#include "Arena.h"
+#include "Autoajuste.h"
+#include "Cola.h"
+#include "Espera.h"
+#include "LectorXz.h"
+#include "Lote.h"
+
+/**
+ * @details
+ * ### Detalles de sincronización
+ * - **Fin de producción**: `terminado.store(true, std::memory_order_release)` cuando el último lector completa su lectura.
+ * - **Consumo**: tras `terminado.load(memory_order_acquire)` y `cola.vacia()` se garantiza que no llegarán más elementos.
+ * - **Espera**: los hilos sin trabajo giran, ceden y finalmente duermen en un `edad::Timbre` que los lectores tocan
+ *   al encolar (`--espera`, ver Espera.h); `--metricas-espera` informa cuánto tiempo pasó cada hilo en cada fase.
+ *
+ * @remark Con `--histograma=mapa`, `concurrent_flat_map::visit` asegura exclusión por clave (no por mapa completo),
+ *         reduciendo contención respecto a un `std::unordered_map` + `#pragma omp critical`.
+ */
+void edad::contar_cola(const Opciones& opciones, const std::vector<Calculadora>& calculadoras, Resultado& resultado) {
+    const std::string ruta = opciones.ruta;
+
+    /// Capacidad de la cola: potencia de 2 suele mejorar el rendimiento de estructuras lock-free por alineación y máscaras.
+    const std::size_t capacidad = 131072u;
+
+    /// Modo histórico (`--lote=0`): un elemento de la cola por línea.
+    const bool por_linea = opciones.lineas_por_lote == 0u;
+
+    /// Hilos lectores (`--lectores`): cada uno copia a la cola las líneas de sus rangos del archivo.
+    const std::size_t lectores = opciones.lectores;
+
+    /// Hilos de la región: los lectores más los consumidores (`--consumidores`, por omisión el resto de
+    /// `OMP_NUM_THREADS`). Todos consumen (los lectores, al terminar de leer) y cada uno usa su omp_get_thread_num()
+    /// como identificador de consumidor en la cola (ver Cola.h); el lector `k` es además el productor `k`.
+    /// Se acota a `OMP_THREAD_LIMIT` (lotes y autoajuste se dimensionan con esta cifra); si aun así el equipo resulta
+    /// menor (`OMP_DYNAMIC`), las colas se crean para el equipo real dentro de la región.
+    const std::size_t hilos_omp = static_cast<std::size_t> (omp_get_max_threads());
+    const std::size_t hilos = std::min(static_cast<std::size_t> (omp_get_thread_limit()),
+            lectores + (opciones.consumidores != 0u ? opciones.consumidores : hilos_omp - std::min(lectores, hilos_omp)));
+
+    /**
+     * @brief Cola de punteros a líneas de `arena` (solo en el modo histórico por línea), de la implementación `--cola`.
+     * @details
+     * - Tipo trivial requerido ⇒ se usan punteros crudos.
+     * - Un productor por lector, múltiples consumidores (todos los hilos); `capacidad` elementos por lector.
+     * - Se crea dentro de la región, cuando se conoce el equipo real (ver `crear_colas`): OpenMP puede dar menos
+     *   hilos que los pedidos (`OMP_THREAD_LIMIT`, `OMP_DYNAMIC`) y en los anillos sin robo los de un consumidor
+     *   inexistente no los vaciaría nadie.
+     * - **Propiedad de memoria**: cada línea encolada debe ser soltada exactamente una vez por un consumidor
+     *   (`ArenaLineas::soltar`); la arena se declara antes que la cola, así que la sobrevive.
+     */
+    ArenaLineas arena;
+    std::optional<ColaDe<ArenaLineas::Linea>> cola_lineas;
+
+    /**
+     * @brief Lotes reciclables (ver Lote.h): `LOTES_POR_HILO` por hilo, creados una vez.
+     * @details Circulan entre `libres` (vacíos, para los lectores) y `llenos` (para los consumidores); nunca
+     *          hay más de `lotes.size()` lotes en vuelo, así que la memoria queda acotada aunque los lectores
+     *          sean más rápidos que los consumidores. `llenos` es de la implementación `--cola`, con capacidad
+     *          para todos los lotes por cada lector (en los anillos cada lector tiene los suyos); `libres` recibe
+     *          de todos los consumidores y la vacían los lectores, así que queda en Boost (MPMC).
+     */
+    constexpr std::size_t LOTES_POR_HILO = 4u;
+    std::vector<Lote> lotes;
+    if (!por_linea) {
+        lotes.assign(LOTES_POR_HILO * hilos, Lote(opciones.lineas_por_lote));
+    }
+    boost::lockfree::queue<Lote*> libres(std::max<std::size_t>(lotes.size(), 1u));
+    std::optional<ColaDe<Lote>> cola_lotes;
+    for (Lote& lote : lotes) {
+        libres.push(&lote);
+    }
+
+    // Crea `cola_lineas` y `cola_lotes` para un equipo de @p equipo hilos, de los que @p productores son lectores.
+    auto crear_colas = [&](std::size_t productores, std::size_t equipo) {
+        cola_lineas.emplace(crear_cola(opciones.cola, por_linea ? capacidad * productores : 2u, productores, equipo));
+        cola_lotes.emplace(crear_cola(opciones.cola, std::max<std::size_t>(lotes.size(), 2u) * productores, productores, equipo));
+    };
+
+    /**
+     * @brief Marcas de agua y autoajuste (ver Autoajuste.h), solo con lotes.
+     * @details `en_cola` cuenta los lotes llenos publicados y aún no tomados. Los valores vigentes son atómicos:
+     *          el lector 0 los cambia al muestrear y los lectores los leen al tomar un lote. Sin `--marca-alta`
+     *          ni `--autoajuste`, la marca alta es inalcanzable (el lector solo consume si no hay lotes libres).
+     */
+    const bool con_marcas = !por_linea && (opciones.marca_alta != 0u || opciones.autoajuste);
+    const bool con_autoajuste = !por_linea && opciones.autoajuste;
+    AjusteCola inicial;
+    inicial.lineas_por_lote = opciones.lineas_por_lote;
+    inicial.marca_alta = opciones.marca_alta != 0u ? opciones.marca_alta : lotes.size();
+    inicial.marca_baja = opciones.marca_baja != 0u ? opciones.marca_baja : inicial.marca_alta / 2u;
+    Autoajuste autoajuste(inicial, LOTES_POR_HILO * hilos, hilos - std::min(lectores, hilos));
+    std::atomic<std::size_t> en_cola{0u};
+    std::atomic<std::size_t> lote_vigente{autoajuste.ajuste().lineas_por_lote};
+    std::atomic<std::size_t> marca_alta{con_marcas ? autoajuste.ajuste().marca_alta : std::numeric_limits<std::size_t>::max()};
+    std::atomic<std::size_t> marca_baja{autoajuste.ajuste().marca_baja};
+    std::vector<SondeoCola> sondeos(hilos);
+
+    /**
+     * @brief Mapa concurrente (edad → ocurrencias), solo con `--histograma=mapa`.
+     * @details
+     * - `try_emplace(clave, 0)`: crea la entrada si no existe (valor inicial 0).
+     * - `visit(clave, lambda)`: sección crítica fina por clave; el *lambda* ve un `value_type&`.
+     * - Buckets iniciales: 4096 para minimizar *rehash* bajo alta concurrencia.
+     * @note Evitar iteradores persistentes: pueden invalidarse tras rehash interno.
+     */
+    const bool con_mapa = opciones.histograma == ModoHistograma::mapa;
+    boost::unordered::concurrent_flat_map<int, int> mapa(con_mapa ? 4096u : 0u);
+
+    /// Señal de finalización de la lectura: la da el último lector en terminar. `release/acquire` garantiza
+    /// visibilidad del fin a consumidores.
+    std::atomic<bool> terminado{false};
+    std::atomic<std::size_t> lectores_terminados{0u};
+
+    /// Timbres para la espera de los hilos sin trabajo (ver Espera.h): los lectores tocan `hay_trabajo` al encolar
+    /// y al terminar; los consumidores tocan `hay_lote_libre` al devolver un lote.
+    Timbre hay_trabajo;
+    Timbre hay_lote_libre;
+    std::vector<ContadoresEspera> contadores_espera(hilos);
+
+    const bool por_fechas = opciones.agregacion == ModoAgregacion::fechas;
+
+    /**
+     * @brief Entrada, abierta antes de la región para que todos los lectores la compartan.
+     * @details Un archivo proyectado se divide en `4 · lectores` rangos alineados a '\n' que los lectores toman de
+     *          `siguiente_rango` (así un lector lento no retrasa el fin); un `.xz` se reparte por búferes
+     *          descomprimidos, que los lectores toman directamente de `edad::LectorXz` (thread-safe).
+     */
+    constexpr std::size_t RANGOS_POR_LECTOR = 4u;
+    std::optional<ArchivoMapeado> archivo;
+    std::optional<LectorXz> lector;
+    std::vector<std::string_view> rangos;
+    std::atomic<std::size_t> siguiente_rango{0u};
+    try {
+        if (es_flujo(ruta)) {
+            // Descompresión en hilos aparte, solapada con el encolado (bloques en paralelo si el .xz los tiene).
+            lector.emplace(ruta, hilos + 2u, std::size_t{4} << 20, hilos);
+        } else {
+            // Proyección en memoria: se separan líneas con memchr en lugar de std::getline.
+            archivo.emplace(ruta, opciones.paginas_grandes);
+            rangos = dividir_en_rangos(archivo->contenido(), RANGOS_POR_LECTOR * lectores);
+        }
+    } catch (const std::runtime_error& error) {
+        resultado.error = std::string("No se pudo abrir el archivo: ") + error.what();
+    }
+
+#pragma omp parallel num_threads(static_cast<int> (hilos))
+    {
+        // Colas para el equipo real; la barrera implícita de `single` las publica antes de que alguien las use.
+        const std::size_t lectores_equipo = std::min(lectores, static_cast<std::size_t> (omp_get_num_threads()));
+#pragma omp single
+        crear_colas(lectores_equipo, static_cast<std::size_t> (omp_get_num_threads()));
+        ColaDe<ArenaLineas::Linea>& cola = *cola_lineas;
+        ColaDe<Lote>& llenos = *cola_lotes;
+
+        // Estado de cada hilo; los lectores también lo usan si procesan lotes mientras esperan uno libre.
+        // Las líneas se clasifican en bloques de LINEAS_POR_BLOQUE (parseo y conversión a días vectorizados)
+        // en lugar de una llamada por línea.
+        Acumulador acumulador(calculadoras, por_fechas);
+        std::string_view vistas[LINEAS_POR_BLOQUE];
+
+        auto procesar_vistas = [&](std::size_t cantidad) {
+            if (con_mapa) {
+                acumulador.procesar(vistas, cantidad, [&mapa](int clave) {
+                    // Asegurar existencia y sumar de forma thread-safe por clave.
+                    mapa.try_emplace(clave, 0);
+                    mapa.visit(clave, [](boost::unordered::concurrent_flat_map<int, int>::value_type & par) {
+                        ++par.second; // incremento atómico bajo exclusión por clave
+                    });
+                });
+            } else {
+                acumulador.procesar(vistas, cantidad);
+            }
+        };
+
+        // Deja un lote listo para llenar, con el tamaño vigente si hay autoajuste.
+        auto preparar = [&](Lote& lote) {
+            lote.limpiar();
+            if (con_autoajuste) {
+                lote.redimensionar(lote_vigente.load(std::memory_order_relaxed));
+            }
+        };
+
+        // Recorre un lote completo en bloques, sin tocar la cola entre bloques.
+        auto procesar_lote = [&](const Lote& lote) {
+            for (std::size_t desde = 0u; desde < lote.lineas(); desde += LINEAS_POR_BLOQUE) {
+                const std::size_t cantidad = std::min(LINEAS_POR_BLOQUE, lote.lineas() - desde);
+                lote.vistas(desde, cantidad, vistas);
+                procesar_vistas(cantidad);
+            }
+        };
+
+        // Modo histórico: cada hilo junta hasta LINEAS_POR_BLOQUE líneas antes de clasificarlas.
+        const std::size_t consumidor = static_cast<std::size_t> (omp_get_thread_num());
+        ArenaLineas::Linea* pendientes[LINEAS_POR_BLOQUE];
+        std::size_t cantidad = 0u;
+
+        auto procesar_bloque = [&]() {
+            for (std::size_t k = 0u; k < cantidad; ++k) {
+                vistas[k] = pendientes[k]->texto();
+            }
+            procesar_vistas(cantidad);
+            arena.soltar(pendientes, cantidad); // IMPORTANTÍSIMO: soltar SIEMPRE las líneas consumidas
+            cantidad = 0u;
+        };
+
+        // --metricas-memoria: cola, lotes y estado de cada hilo ya están creados; lo que se reserve desde aquí es
+        // régimen (la barrera implícita de `single` impide que algún hilo empiece antes de la foto).
+        if (opciones.metricas_memoria) {
+#pragma omp barrier
+#pragma omp single
+            resultado.memoria_preparada = contadores_memoria();
+        }
+
+        // LECTORES: los primeros `lectores` hilos (o todos, si OpenMP dio menos) leen y encolan; el resto consume
+        // en paralelo desde el inicio.
+        if (consumidor < lectores_equipo) {
+            const std::size_t productor = consumidor;
+            Lote* actual = nullptr;
+            Esperador espera_productor(opciones.espera, hay_lote_libre, contadores_espera[consumidor]);
+
+            // Publica un lote lleno. La capacidad de cada productor alcanza para todos los lotes, pero con varios
+            // lectores una cola acotada puede rechazarlo un instante (un consumidor reclamó la celda y aún no la
+            // liberó): se reintenta. Un lector que espera un lote libre también puede tomar uno lleno (y en los
+            // anillos sin robo, solo él los de sus anillos), así que se lo despierta además.
+            // Muestreo del autoajuste (solo el lector 0, al publicar cada lote): ocupación media de la cola y
+            // reintentos y vaciamientos de todos los hilos en el período.
+            std::size_t suma_ocupacion = 0u;
+            std::size_t publicados = 0u;
+            std::uint64_t reintentos_previos = 0u;
+            std::uint64_t vaciamientos_previos = 0u;
+            std::chrono::steady_clock::time_point proxima_muestra = std::chrono::steady_clock::now() + PERIODO_AUTOAJUSTE;
+            auto muestrear = [&]() {
+                suma_ocupacion += en_cola.load(std::memory_order_relaxed);
+                ++publicados;
+                const std::chrono::steady_clock::time_point ahora = std::chrono::steady_clock::now();
+                if (ahora < proxima_muestra) {
+                    return;
+                }
+                proxima_muestra = ahora + PERIODO_AUTOAJUSTE;
+                std::uint64_t reintentos = 0u;
+                std::uint64_t vaciamientos = 0u;
+                for (const SondeoCola& sondeo : sondeos) {
+                    reintentos += sondeo.reintentos.load(std::memory_order_relaxed);
+                    vaciamientos += sondeo.vaciamientos.load(std::memory_order_relaxed);
+                }
+                MuestraCola muestra;
+                muestra.ocupacion = static_cast<double> (suma_ocupacion) / static_cast<double> (publicados);
+                muestra.reintentos = reintentos - reintentos_previos;
+                muestra.vaciamientos = vaciamientos - vaciamientos_previos;
+                reintentos_previos = reintentos;
+                vaciamientos_previos = vaciamientos;
+                suma_ocupacion = 0u;
+                publicados = 0u;
+                if (autoajuste.observar(muestra)) {
+                    lote_vigente.store(autoajuste.ajuste().lineas_por_lote, std::memory_order_relaxed);
+                    marca_alta.store(autoajuste.ajuste().marca_alta, std::memory_order_relaxed);
+                    marca_baja.store(autoajuste.ajuste().marca_baja, std::memory_order_relaxed);
+                }
+            };
+            const bool muestrea = con_autoajuste && productor == 0u;
+
+            auto publicar = [&](Lote* lote) {
+                en_cola.fetch_add(1u, std::memory_order_relaxed);
+                while (!llenos.encolar(lote, productor)) {
+                    std::this_thread::yield();
+                }
+                hay_trabajo.tocar();
+                if (lectores_equipo > 1u) {
+                    hay_lote_libre.tocar();
+                }
+                if (muestrea && !autoajuste.convergido()) {
+                    muestrear();
+                }
+            };
+
+            // Modo por lotes: copia las líneas de 'texto' a lotes reciclados y encola un puntero por lote lleno.
+            // 'ayudando': la cola llegó a la marca alta y el lector consume hasta que baje a la baja.
+            bool ayudando = false;
+            auto encolar_lotes = [&](std::string_view texto) {
+                while (!texto.empty()) {
+                    bool reintento = false;
+                    while (actual == nullptr) {
+                        const std::size_t ocupados = en_cola.load(std::memory_order_relaxed);
+                        ayudando = ayudando ? ocupados > marca_baja.load(std::memory_order_relaxed)
+                                : ocupados >= marca_alta.load(std::memory_order_relaxed);
+                        Lote* lleno = nullptr;
+                        if (!ayudando && libres.pop(actual)) {
+                            espera_productor.reiniciar();
+                            preparar(*actual);
+                        } else if (llenos.desencolar(lleno, consumidor)) {
+                            // Sin lotes libres o sobre la marca: el lector ayuda a consumir (con un solo hilo no hay
+                            // otro que lo haga).
+                            en_cola.fetch_sub(1u, std::memory_order_relaxed);
+                            procesar_lote(*lleno);
+                            if (ayudando) {
+                                libres.push(lleno);
+                                hay_lote_libre.tocar();
+                            } else {
+                                preparar(*lleno);
+                                actual = lleno;
+                            }
+                            espera_productor.reiniciar();
+                        } else {
+                            espera_productor.esperar();
+                        }
+                        if (actual == nullptr && !reintento) {
+                            reintento = true;
+                            sondeos[consumidor].reintentos.fetch_add(1u, std::memory_order_relaxed);
+                        }
+                    }
+                    actual->llenar(texto);
+                    if (actual->lleno()) {
+                        publicar(actual);
+                        actual = nullptr;
+                    }
+                }
+            };
+
+            // Modo histórico: copia a la arena cada línea de 'texto' (debe sobrevivir al búfer y la cola solo admite
+            // punteros). El escritor sella su última losa al salir del bloque de lectura.
+            std::optional<ArenaLineas::Escritor> escritor;
+            if (por_linea) {
+                escritor.emplace(arena);
+            }
+            auto encolar_lineas = [&](std::string_view texto) {
+                std::string_view lineas[LINEAS_POR_BLOQUE];
+                std::size_t leidas;
+                while ((leidas = siguientes_lineas(texto, lineas, LINEAS_POR_BLOQUE)) > 0u) {
+                    for (std::size_t k = 0u; k < leidas; ++k) {
+                        ArenaLineas::Linea* p = escritor->copiar(lineas[k]);
+                        // Cola acotada llena: el lector procesa un bloque él mismo (con un solo hilo no hay otro que lo haga).
+                        while (!cola.encolar(p, productor)) {
+                            while (cantidad < LINEAS_POR_BLOQUE && cola.desencolar(pendientes[cantidad], consumidor)) {
+                                ++cantidad;
+                            }
+                            if (cantidad > 0u) {
+                                procesar_bloque();
+                            } else {
+                                std::this_thread::yield(); // otro hilo vació la cola entre ambos intentos: reintentar ya
+                            }
+                        }
+                        hay_trabajo.tocar();
+                    }
+                }
+            };
+
+            auto encolar = [&](std::string_view texto) {
+                if (por_linea) {
+                    encolar_lineas(texto);
+                } else {
+                    encolar_lotes(texto);
+                }
+            };
+            if (lector) {
+                TrozoXz trozo;
+                while (lector->tomar(trozo)) {
+                    encolar(trozo.texto);
+                    lector->devolver(trozo);
+                }
+            } else {
+                std::size_t indice;
+                while ((indice = siguiente_rango.fetch_add(1u, std::memory_order_relaxed)) < rangos.size()) {
+                    encolar(rangos[indice]);
+                }
+            }
+            if (actual != nullptr) {
+                // Último lote, parcialmente lleno (o vacío si el rango terminó justo en un borde de lote).
+                publicar(actual);
+            }
+            if (lectores_terminados.fetch_add(1u, std::memory_order_acq_rel) + 1u == lectores_equipo) {
+                terminado.store(true, std::memory_order_release);
+                hay_trabajo.tocar(); // despertar a los estacionados para que vean el fin
+            }
+        }
+
+        // CONSUMIDORES: todos los hilos (incluidos los lectores tras terminar la lectura).
+        Esperador espera(opciones.espera, hay_trabajo, contadores_espera[consumidor]);
+        if (por_linea) {
+            for (;;) {
+                ArenaLineas::Linea* fecha = nullptr;
+                if (cola.desencolar(fecha, consumidor)) {
+                    espera.reiniciar();
+                    pendientes[cantidad++] = fecha;
+                    if (cantidad == LINEAS_POR_BLOQUE) {
+                        procesar_bloque();
+                    }
+                } else if (cantidad > 0u) {
+                    // Cola momentáneamente vacía: procesar el bloque parcial antes de esperar.
+                    procesar_bloque();
+                } else {
+                    // Terminar si ya no habrá más producción y la cola está vacía.
+                    if (terminado.load(std::memory_order_acquire) && cola.vacia()) {
+                        break;
+                    }
+                    espera.esperar();
+                }
+            }
+        } else {
+            // Un pop y un push por lote (miles de líneas) en lugar de un pop y un delete por línea.
+            bool con_trabajo = false;
+            for (;;) {
+                Lote* lote = nullptr;
+                if (llenos.desencolar(lote, consumidor)) {
+                    en_cola.fetch_sub(1u, std::memory_order_relaxed);
+                    espera.reiniciar();
+                    con_trabajo = true;
+                    procesar_lote(*lote);
+                    libres.push(lote);
+                    hay_lote_libre.tocar();
+                } else {
+                    if (terminado.load(std::memory_order_acquire) && llenos.vacia()) {
+                        break;
+                    }
+                    if (con_trabajo) {
+                        // Un vaciamiento por racha sin lotes, no por intento fallido (ver Autoajuste.h).
+                        con_trabajo = false;
+                        sondeos[consumidor].vaciamientos.fetch_add(1u, std::memory_order_relaxed);
+                    }
+                    espera.esperar();
+                }
+            }
+        }
+        // Combinación única por hilo: 131 sumas bajo exclusión, en lugar de sincronizar por línea.
+#pragma omp critical(resultado)
+        acumulador.volcar(resultado);
+
+        // --metricas-memoria: fin del régimen, antes de que se destruyan el estado de cada hilo, la cola y los lotes.
+        if (opciones.metricas_memoria) {
+#pragma omp barrier
+#pragma omp single
+            resultado.memoria_regimen = contadores_memoria();
+        }
+    }
+
+    if (lector && !lector->error().empty()) {
+        resultado.error = "No se pudo leer el archivo: " + ruta + ": " + lector->error();
+    }
+    if (opciones.metricas_espera) {
+        imprimir_contadores_espera(contadores_espera, std::cerr);
+    }
+    if (con_autoajuste) {
+        autoajuste.imprimir(std::cerr);
+    }
+    if (opciones.metricas_memoria && por_linea) {
+        std::cerr << "Arena de líneas: " << arena.losas() << " losas, " << arena.bytes() / 1024u << " KiB\n";
+    }
+    if (con_mapa) {
+        // Las claves del mapa están en [0,130]: se vuelcan al arreglo para emitirlas en orden.
+        mapa.visit_all([&resultado](const boost::unordered::concurrent_flat_map<int, int>::value_type & par) {
+            resultado.histograma[static_cast<std::size_t> (par.first)] += static_cast<std::uint64_t> (par.second);
+        });
+    }
+}
@@ -0,0 +1,154 @@
+/**
+ * @file
+ * @brief Motor `corrutinas`: pipeline de etapas de C++20 (lectura → análisis → agregación) con canales acotados.
+ *
+ * En `tareas` la lectura, el parseo y la suma van juntos dentro de cada OpenMP task; en `cola`, juntos dentro del
+ * bucle de cada consumidor. Aquí cada paso es una corrutina propia (ver Corrutinas.h), unida a la siguiente por un
+ * @ref edad::Canal acotado, y todas corren en un @ref edad::Planificador de `OMP_NUM_THREADS` hilos:
+ *
+ * @code
+ * leer ──trozos──▶ analizar (× hilos) ──parciales──▶ agregar
+ * @endcode
+ *
+ * - **leer** (una): corta el archivo proyectado en trozos de `--tarea-kib` KiB alineados a '\n' y pide al kernel
+ *   que los lea por adelantado (`edad::ArchivoMapeado::precargar`), así la E/S de los trozos siguientes se solapa
+ *   con el análisis de los actuales. Con `.xz` entrega los búferes de `edad::LectorXz`.
+ * - **analizar** (una por hilo): separa las líneas del trozo y las clasifica en un `edad::Acumulador` parcial
+ *   nuevo; devuelve el trozo (`liberar` o `LectorXz::devolver`) y envía el parcial.
+ * - **agregar** (una): combina cada parcial en el total, que no comparte con nadie (sin atómicos ni secciones
+ *   críticas).
+ *
+ * ## Contrapresión
+ * Cada canal admite dos elementos por hilo. Si `agregar` se atrasa, `analizar` se suspende al enviar; si todos
+ * los analizadores están ocupados, `leer` se suspende al enviar y deja de precargar. Una etapa suspendida no
+ * ocupa un hilo: el hilo reanuda otra corrutina lista o duerme si no hay ninguna, sin girar.
+ *
+ * Agregar una etapa (p. ej. filtrar líneas antes de analizar) es escribir otra corrutina y otro canal, sin tocar
+ * las demás.
+ *
+ * @par Ejecución (ejemplos)
+ * @code{.bash}
+ * OMP_NUM_THREADS=8 ./paralelo --motor=corrutinas datos.csv
+ * OMP_NUM_THREADS=8 ./paralelo --motor=corrutinas --tarea-kib=256 edades.csv.xz
+ * @endcode
+ *
+ * @see edad::contar_corrutinas
+ */
+
+#include "Motor.h"
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <omp.h>
+
+#include "Corrutinas.h"
+#include "LectorXz.h"
+
+namespace {
+
+    /// Trozos en vuelo por hilo en cada canal.
+    constexpr std::size_t ELEMENTOS_POR_HILO = 2u;
+
+    /// Parcial de un trozo, de `analizar` a `agregar`.
+    using Parcial = std::unique_ptr<edad::Acumulador>;
+
+    /// Etapa de lectura de un archivo proyectado: trozos de unos @p bytes, precargados antes de enviarlos.
+    edad::Tarea leer(const edad::ArchivoMapeado& archivo, std::size_t bytes, edad::Canal<edad::TrozoXz>& trozos) {
+        std::string_view resto = archivo.contenido();
+        while (!resto.empty()) {
+            const std::string_view rango = edad::siguiente_rango(resto, bytes);
+            archivo.precargar(rango);
+            co_await trozos.enviar(edad::TrozoXz{rango, 0u});
+        }
+        trozos.cerrar();
+    }
+
+    /**
+     * @brief Etapa de lectura de un `.xz`: los búferes de líneas completas del descompresor.
+     * @details `tomar` puede bloquear este hilo mientras el descompresor llena un búfer; el lector tiene búferes
+     *          para todos los trozos que pueden estar en el canal o en análisis, así que siempre hay uno libre
+     *          para el descompresor y la espera termina.
+     */
+    edad::Tarea leer_xz(edad::LectorXz& lector, edad::Canal<edad::TrozoXz>& trozos) {
+        edad::TrozoXz trozo;
+        while (lector.tomar(trozo)) {
+            co_await trozos.enviar(trozo);
+        }
+        trozos.cerrar();
+    }
+
+    /// Etapa de análisis: un parcial por trozo. Con @p lector, los trozos son suyos; si no, de @p archivo.
+    edad::Tarea analizar(const std::vector<edad::Calculadora>& calculadoras, bool por_fechas, const edad::ArchivoMapeado* archivo,
+            edad::LectorXz* lector, edad::Canal<edad::TrozoXz>& trozos, edad::Canal<Parcial>& parciales) {
+        while (std::optional<edad::TrozoXz> trozo = co_await trozos.recibir()) {
+            Parcial parcial = std::make_unique<edad::Acumulador>(calculadoras, por_fechas);
+            parcial->procesar_rango(trozo->texto);
+            if (lector != nullptr) {
+                lector->devolver(*trozo);
+            } else {
+                archivo->liberar(trozo->texto);
+            }
+            co_await parciales.enviar(std::move(parcial));
+        }
+        parciales.cerrar();
+    }
+
+    /// Etapa de agregación: único dueño de @p total.
+    edad::Tarea agregar(edad::Canal<Parcial>& parciales, edad::Acumulador& total) {
+        while (std::optional<Parcial> parcial = co_await parciales.recibir()) {
+            total.combinar(**parcial);
+        }
+    }
+}
+
+/**
+ * @details
+ * @par Seguridad en hilos
+ * Cada trozo y cada parcial pertenece a una sola etapa a la vez (el canal transfiere la propiedad); el total solo
+ * lo toca `agregar`, y @ref edad::Planificador::esperar lo publica a este hilo.
+ */
+void edad::contar_corrutinas(const Opciones& opciones, const std::vector<Calculadora>& calculadoras, Resultado& resultado) {
+    const std::string ruta = opciones.ruta;
+    const bool por_fechas = opciones.agregacion == ModoAgregacion::fechas;
+    const std::size_t hilos = static_cast<std::size_t> (omp_get_max_threads());
+    const std::size_t capacidad = ELEMENTOS_POR_HILO * hilos;
+
+    Acumulador total(calculadoras, por_fechas);
+    try {
+        std::optional<ArchivoMapeado> archivo;
+        std::optional<LectorXz> lector;
+        if (es_flujo(ruta)) {
+            // Búferes para el canal, uno por analizador, el que retiene 'leer_xz' y uno libre para el descompresor.
+            lector.emplace(ruta, capacidad + hilos + 2u, std::size_t{4} << 20, hilos);
+        } else {
+            archivo.emplace(ruta, opciones.paginas_grandes);
+        }
+
+        // Se declara antes que los canales: se destruye (y une sus hilos) después de ellos.
+        Planificador planificador(hilos);
+        Canal<TrozoXz> trozos(planificador, capacidad);
+        Canal<Parcial> parciales(planificador, capacidad, hilos);
+        if (lector) {
+            planificador.lanzar(leer_xz(*lector, trozos));
+        } else {
+            planificador.lanzar(leer(*archivo, opciones.kib_por_tarea * 1024u, trozos));
+        }
+        for (std::size_t i = 0u; i < hilos; ++i) {
+            planificador.lanzar(analizar(calculadoras, por_fechas, archivo ? &*archivo : nullptr, lector ? &*lector : nullptr, trozos, parciales));
+        }
+        planificador.lanzar(agregar(parciales, total));
+        planificador.esperar();
+
+        if (lector && !lector->error().empty()) {
+            resultado.error = "No se pudo leer el archivo: " + ruta + ": " + lector->error();
+        }
+    } catch (const std::runtime_error& error) {
+        resultado.error = std::string("No se pudo abrir el archivo: ") + error.what();
+    }
+    total.volcar(resultado);
+}
@@ -0,0 +1,212 @@
+/**
+ * @file
+ * @brief Motor `numa`: hilos fijados a núcleos, una porción del archivo por nodo NUMA y un acumulador por nodo.
+ *
+ * En el motor `cola` un único lector llena los lotes: sus páginas quedan en el nodo del lector y, en un equipo de
+ * dos zócalos, los consumidores del otro nodo pagan un acceso remoto por cada línea. Aquí no hay lector: cada hilo
+ * se fija a un núcleo (`edad::fijar_hilo`) y recorre la porción del archivo de su nodo, así las páginas que lee
+ * por primera vez (y, al venir de disco, las que el kernel ubica en la *page cache*) quedan en memoria local.
+ *
+ * ## Idea general
+ * - **Topología**: nodos y núcleos de `/sys/devices/system/node` dentro de la afinidad del proceso
+ *   (`edad::leer_topologia_numa`). Los `OMP_NUM_THREADS` hilos se reparten intercalando nodos
+ *   (`edad::asignar_hilos_numa`): con menos hilos que núcleos todos los nodos aportan su ancho de banda.
+ * - **Porciones**: el archivo proyectado se corta en una porción por nodo, proporcional a sus hilos y alineada a
+ *   '\n' (`edad::lineas_en_rango`). Dentro de su porción, los hilos del nodo toman bloques de `--tarea-kib` KiB con
+ *   un cursor atómico propio del nodo (la línea de caché del cursor tampoco cruza la interconexión).
+ * - **Robo entre nodos**: un hilo que agotó su porción toma bloques de las de los demás nodos. Esos bloques se
+ *   leen en remoto, pero evitan que un nodo más lento (o con más núcleos ocupados) retrase el final.
+ * - **Acumulación**: cada hilo clasifica en su `edad::Acumulador`; al terminar lo combina en el del nodo, que crea
+ *   el primer hilo del nodo en terminar (en memoria local). Los acumuladores por nodo se vuelcan una vez al final.
+ * - **Entrada `.xz`**: los búferes descomprimidos los escribe el hilo del lector, así que no hay porción local que
+ *   repartir: los hilos fijados toman búferes del `edad::LectorXz` como en `bloques` y se conserva la acumulación
+ *   por nodo y las métricas.
+ *
+ * ## Métricas
+ * `--metricas-numa` informa por @c stderr, por nodo, los MiB clasificados por sus hilos, el tiempo hasta que
+ * terminó el último y el caudal resultante; también cuántos MiB se robaron de otros nodos (si son muchos, las
+ * porciones están desbalanceadas o un nodo tiene sus núcleos ocupados).
+ *
+ * En un equipo de un solo nodo (o sin sysfs) el motor se comporta como `bloques` con hilos fijados.
+ *
+ * @par Ejecución (ejemplos)
+ * @code{.bash}
+ * OMP_NUM_THREADS=32 ./paralelo --motor=numa --metricas-numa datos.csv
+ * OMP_NUM_THREADS=16 numactl --cpunodebind=0,1 ./paralelo --motor=numa datos.csv   # respeta la afinidad dada
+ * @endcode
+ *
+ * @see edad::contar_numa
+ */
+
+#include "Motor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <omp.h>
+
+#include "LectorXz.h"
+#include "Numa.h"
+
+namespace {
+
+    using Reloj = std::chrono::steady_clock;
+
+    /**
+     * @brief Estado compartido de un nodo: su porción, su cursor y su acumulador.
+     * @details Alineado a línea de caché: los cursores de nodos distintos no comparten línea.
+     */
+    struct alignas(64) EstadoNodo {
+        /// Líneas de la porción del nodo (vacía con entrada `.xz`).
+        std::string_view porcion;
+
+        /// Desplazamiento en @ref porcion del siguiente bloque libre.
+        std::atomic<std::size_t> cursor{0u};
+
+        /// Protege @ref acumulador y @ref metricas.
+        std::mutex mutex;
+
+        /// Acumulado de los hilos del nodo; lo crea el primero que termina.
+        std::unique_ptr<edad::Acumulador> acumulador;
+
+        edad::MetricasNodo metricas;
+    };
+
+    /**
+     * @brief Clasifica bloques de @p bytes de la porción de @p nodo hasta agotarla.
+     * @return Bytes de texto clasificados.
+     */
+    std::uint64_t recorrer_porcion(EstadoNodo& nodo, std::size_t bytes, const edad::ArchivoMapeado& archivo, edad::Acumulador& acumulador) {
+        std::uint64_t total = 0u;
+        std::size_t desde;
+        while ((desde = nodo.cursor.fetch_add(bytes, std::memory_order_relaxed)) < nodo.porcion.size()) {
+            const std::string_view rango = edad::lineas_en_rango(nodo.porcion, desde, desde + bytes);
+            acumulador.procesar_rango(rango);
+            archivo.liberar(rango);
+            total += rango.size();
+        }
+        return total;
+    }
+}
+
+/**
+ * @details
+ * @par Seguridad en hilos
+ * Cada hilo acumula solo en su acumulador; el del nodo se toca bajo el mutex del nodo, una vez por hilo.
+ * Al salir de la región paralela cada hilo recupera la afinidad que tenía, para no condicionar otras regiones.
+ */
+void edad::contar_numa(const Opciones& opciones, const std::vector<Calculadora>& calculadoras, Resultado& resultado) {
+    const std::string ruta = opciones.ruta;
+    const bool por_fechas = opciones.agregacion == ModoAgregacion::fechas;
+    const std::size_t hilos = static_cast<std::size_t> (omp_get_max_threads());
+    const std::vector<NodoNuma> nodos = leer_topologia_numa();
+    const std::vector<PuestoNuma> puestos = asignar_hilos_numa(nodos, hilos);
+
+    std::vector<EstadoNodo> estados(nodos.size());
+    for (const PuestoNuma& puesto : puestos) {
+        ++estados[puesto.nodo].metricas.hilos;
+    }
+
+    // Cuerpo común: fijar el hilo, clasificar con `trabajar` y combinar en el acumulador del nodo.
+    auto ejecutar = [&](auto&& trabajar) {
+        const Reloj::time_point inicio = Reloj::now();
+#pragma omp parallel num_threads(static_cast<int> (hilos))
+        {
+            const std::size_t hilo = static_cast<std::size_t> (omp_get_thread_num());
+            const PuestoNuma puesto = puestos[hilo % puestos.size()];
+            cpu_set_t anterior;
+            const bool fijado = fijar_hilo(puesto.cpu, anterior);
+
+            // Creado después de fijar el hilo: su memoria es local al nodo.
+            Acumulador acumulador(calculadoras, por_fechas);
+            std::uint64_t ajenos = 0u;
+            const std::uint64_t bytes = trabajar(puesto.nodo, acumulador, ajenos);
+            const std::uint64_t ns = static_cast<std::uint64_t> (std::chrono::duration_cast<std::chrono::nanoseconds>(Reloj::now() - inicio).count());
+
+            EstadoNodo& nodo = estados[puesto.nodo];
+            {
+                std::lock_guard<std::mutex> cerrojo(nodo.mutex);
+                if (nodo.acumulador) {
+                    nodo.acumulador->combinar(acumulador);
+                } else {
+                    nodo.acumulador = std::make_unique<Acumulador>(acumulador);
+                }
+                nodo.metricas.bytes += bytes;
+                nodo.metricas.bytes_ajenos += ajenos;
+                nodo.metricas.ns = std::max(nodo.metricas.ns, ns);
+            }
+            if (fijado) {
+                restaurar_afinidad(anterior);
+            }
+        }
+    };
+
+    try {
+        if (es_flujo(ruta)) {
+            // Un búfer por hilo más dos, como en los demás motores.
+            LectorXz lector(ruta, hilos + 2u, std::size_t{4} << 20, hilos);
+            ejecutar([&lector](std::size_t, Acumulador& acumulador, std::uint64_t&) {
+                std::uint64_t bytes = 0u;
+                TrozoXz trozo;
+                while (lector.tomar(trozo)) {
+                    acumulador.procesar_rango(trozo.texto);
+                    bytes += trozo.texto.size();
+                    lector.devolver(trozo);
+                }
+                return bytes;
+            });
+            if (!lector.error().empty()) {
+                resultado.error = "No se pudo leer el archivo: " + ruta + ": " + lector.error();
+            }
+        } else {
+            const ArchivoMapeado archivo(ruta, opciones.paginas_grandes);
+            const std::string_view texto = archivo.contenido();
+            const std::size_t bytes = opciones.kib_por_tarea * 1024u;
+
+            // Porciones proporcionales a los hilos de cada nodo: la del nodo n empieza en el byte que corresponde a
+            // los hilos de los nodos anteriores (sin desbordar con archivos grandes).
+            auto frontera = [&texto, &puestos](std::size_t hilos_previos) {
+                return texto.size() / puestos.size() * hilos_previos + texto.size() % puestos.size() * hilos_previos / puestos.size();
+            };
+            std::size_t hilos_previos = 0u;
+            for (EstadoNodo& estado : estados) {
+                const std::size_t desde = frontera(hilos_previos);
+                hilos_previos += estado.metricas.hilos;
+                estado.porcion = lineas_en_rango(texto, desde, frontera(hilos_previos));
+            }
+
+            ejecutar([&estados, &archivo, bytes](std::size_t propio, Acumulador& acumulador, std::uint64_t& ajenos) {
+                std::uint64_t total = recorrer_porcion(estados[propio], bytes, archivo, acumulador);
+                for (std::size_t salto = 1u; salto < estados.size(); ++salto) {
+                    const std::uint64_t robados = recorrer_porcion(estados[(propio + salto) % estados.size()], bytes, archivo, acumulador);
+                    total += robados;
+                    ajenos += robados;
+                }
+                return total;
+            });
+        }
+    } catch (const std::runtime_error& error) {
+        resultado.error = std::string("No se pudo abrir el archivo: ") + error.what();
+    }
+
+    std::vector<MetricasNodo> metricas;
+    metricas.reserve(estados.size());
+    for (const EstadoNodo& estado : estados) {
+        if (estado.acumulador) {
+            estado.acumulador->volcar(resultado);
+        }
+        metricas.push_back(estado.metricas);
+    }
+    if (opciones.metricas_numa) {
+        imprimir_metricas_numa(nodos, metricas, std::cerr);
+    }
+}
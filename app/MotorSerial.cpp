@@ -0,0 +1,50 @@
+/**
+ * @file
+ * @brief Motor `serial`: un solo hilo, sin OpenMP. Referencia de corrección y línea base de aceleración.
+ *
+ * Recorre el archivo proyectado (o los búferes de `edad::LectorXz`, con su hilo descompresor) de principio a fin
+ * con un único `edad::Acumulador`. Sirve para comprobar que un motor paralelo produce la misma salida y para medir
+ * su aceleración real (no contra sí mismo con un hilo, que ya paga la sincronización):
+ * @code{.bash}
+ * cmp <(./paralelo --motor=serial --as-of=2025-01-01 datos.csv) <(./paralelo --motor=tbb --as-of=2025-01-01 datos.csv)
+ * @endcode
+ *
+ * @see edad::contar_serial
+ */
+
+#include "Motor.h"
+
+#include <stdexcept>
+#include <string>
+
+#include "LectorXz.h"
+
+void edad::contar_serial(const Opciones& opciones, const std::vector<Calculadora>& calculadoras, Resultado& resultado) {
+    Acumulador acumulador(calculadoras, opciones.agregacion == ModoAgregacion::fechas);
+    try {
+        if (es_flujo(opciones.ruta)) {
+            // Un solo hilo de descompresión: el .xz se lee en orden, solapado con la clasificación.
+            LectorXz lector(opciones.ruta);
+            TrozoXz trozo;
+            while (lector.tomar(trozo)) {
+                acumulador.procesar_rango(trozo.texto);
+                lector.devolver(trozo);
+            }
+            if (!lector.error().empty()) {
+                resultado.error = "No se pudo leer el archivo: " + opciones.ruta + ": " + lector.error();
+            }
+        } else {
+            const ArchivoMapeado archivo(opciones.ruta, opciones.paginas_grandes);
+            std::string_view resto = archivo.contenido();
+            while (!resto.empty()) {
+                // Por tramos, para descartar de la proyección lo ya recorrido (RSS acotado, como los demás motores).
+                const std::string_view rango = siguiente_rango(resto, opciones.kib_por_tarea * 1024u);
+                acumulador.procesar_rango(rango);
+                archivo.liberar(rango);
+            }
+        }
+    } catch (const std::runtime_error& error) {
+        resultado.error = std::string("No se pudo abrir el archivo: ") + error.what();
+    }
+    acumulador.volcar(resultado);
+}
@@ -0,0 +1,135 @@
+/**
+ * @file
+ * @brief Motor `std-par`: el histograma como `std::transform_reduce` con una política de ejecución paralela de C++17.
+ *
+ * Con el texto en memoria el trabajo completo es una transformación (rango de líneas → histograma parcial) seguida
+ * de una reducción (suma de histogramas, asociativa y conmutativa):
+ * @code{.cpp}
+ * std::transform_reduce(std::execution::par, rangos.begin(), rangos.end(), Acumulador(...),
+ *         combinar, [](std::string_view rango) { Acumulador parcial(...); parcial.procesar_rango(rango); return parcial; });
+ * @endcode
+ * Sin hilos, tareas, colas ni sincronización explícitos: la biblioteca estándar decide el reparto. Sirve de
+ * línea base portable frente a los motores escritos a mano con OpenMP y TBB.
+ *
+ * ## Detalles
+ * - **Elementos**: rangos de `--tarea-kib` KiB alineados a '\n' (`edad::dividir_en_rangos`), no líneas sueltas:
+ *   con un elemento por línea la reducción combinaría un histograma de 131 contadores por cada línea. Dentro de
+ *   cada rango la clasificación ya es vectorizada (`edad::Calculadora::clasificar_lote`).
+ * - **Política**: `par`. El elemento construye su parcial (con agregación `fechas`, un `edad::ConteoFechas` que
+ *   reserva memoria) y descarta su rango con `madvise`; ninguna de las dos cosas está permitida bajo `par_unseq`.
+ *   La vectorización ya ocurre dentro del rango, así que `par_unseq` no aportaría nada.
+ * - **Combinación**: los parciales temporarios se mueven (`CombinarParciales`), no se copia un histograma por paso.
+ * - **Backend**: en libstdc++ las políticas paralelas se ejecutan sobre oneTBB. La cantidad de hilos se acota a
+ *   `OMP_NUM_THREADS` con `tbb::global_control`, como en el resto de los motores.
+ * - **Memoria**: cada rango se descarta de la proyección al terminar (`edad::ArchivoMapeado::liberar`).
+ * - **Entrada `.xz`**: no hay un texto completo en memoria; cada búfer descomprimido de `edad::LectorXz` se reduce
+ *   igual que el archivo proyectado, uno tras otro, mientras el descompresor llena los siguientes.
+ *
+ * @par Ejecución (ejemplos)
+ * @code{.bash}
+ * OMP_NUM_THREADS=8 ./paralelo --motor=std-par datos.csv
+ * ./paralelo --motor=std-par --tarea-kib=256 datos.csv   # más elementos en la reducción
+ * @endcode
+ *
+ * @see edad::contar_std_par
+ */
+
+#include "Motor.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <execution>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <omp.h>
+
+#include <tbb/global_control.h>
+#include <tbb/info.h>
+
+#include "LectorXz.h"
+
+namespace {
+
+    /**
+     * @brief Combinación de dos parciales de la reducción: mueve el temporario y le suma el otro, sin copiar histogramas.
+     * @details libstdc++ llama a la combinación tanto con temporarios como con su propio acumulador (lvalue, que luego
+     *          reasigna); solo cuando ambos son lvalues hace falta una copia.
+     */
+    struct CombinarParciales {
+        edad::Acumulador operator()(edad::Acumulador&& a, edad::Acumulador&& b) const {
+            a.combinar(b);
+            return std::move(a);
+        }
+
+        edad::Acumulador operator()(edad::Acumulador&& a, const edad::Acumulador& b) const {
+            a.combinar(b);
+            return std::move(a);
+        }
+
+        edad::Acumulador operator()(const edad::Acumulador& a, edad::Acumulador&& b) const {
+            b.combinar(a);
+            return std::move(b);
+        }
+
+        edad::Acumulador operator()(const edad::Acumulador& a, const edad::Acumulador& b) const {
+            edad::Acumulador suma(a);
+            suma.combinar(b);
+            return suma;
+        }
+    };
+
+    /**
+     * @brief Reduce las líneas de @p texto en rangos de unos @p bytes y combina el resultado en @p total. Si
+     *        @p archivo no es nulo, cada rango se descarta de su proyección al terminar.
+     */
+    void reducir(std::string_view texto, std::size_t bytes, const std::vector<edad::Calculadora>& calculadoras,
+            bool por_fechas, const edad::ArchivoMapeado* archivo, edad::Acumulador& total) {
+        const std::vector<std::string_view> rangos = edad::dividir_en_rangos(texto, std::max<std::size_t>(1u, texto.size() / bytes));
+        // `par` y no `par_unseq`: el elemento reserva memoria (el parcial) y llama a madvise (liberar).
+        total.combinar(std::transform_reduce(std::execution::par, rangos.begin(), rangos.end(),
+                edad::Acumulador(calculadoras, por_fechas), CombinarParciales{},
+                [&calculadoras, por_fechas, archivo](std::string_view rango) {
+                    edad::Acumulador parcial(calculadoras, por_fechas);
+                    parcial.procesar_rango(rango);
+                    if (archivo != nullptr) {
+                        archivo->liberar(rango);
+                    }
+                    return parcial;
+                }));
+    }
+}
+
+void edad::contar_std_par(const Opciones& opciones, const std::vector<Calculadora>& calculadoras, Resultado& resultado) {
+    const bool por_fechas = opciones.agregacion == ModoAgregacion::fechas;
+    const std::size_t bytes = opciones.kib_por_tarea * 1024u;
+    const int hilos = std::min(omp_get_max_threads(), tbb::info::default_concurrency());
+    const tbb::global_control limite(tbb::global_control::max_allowed_parallelism, static_cast<std::size_t> (hilos));
+
+    Acumulador total(calculadoras, por_fechas);
+    auto reducir_texto = [&](std::string_view texto, const ArchivoMapeado* archivo) {
+        reducir(texto, bytes, calculadoras, por_fechas, archivo, total);
+    };
+    try {
+        if (es_flujo(opciones.ruta)) {
+            LectorXz lector(opciones.ruta, 4u, std::size_t{4} << 20, static_cast<std::size_t> (hilos));
+            TrozoXz trozo;
+            while (lector.tomar(trozo)) {
+                reducir_texto(trozo.texto, nullptr);
+                lector.devolver(trozo);
+            }
+            if (!lector.error().empty()) {
+                resultado.error = "No se pudo leer el archivo: " + opciones.ruta + ": " + lector.error();
+            }
+        } else {
+            const ArchivoMapeado archivo(opciones.ruta, opciones.paginas_grandes);
+            reducir_texto(archivo.contenido(), &archivo);
+        }
+    } catch (const std::runtime_error& error) {
+        resultado.error = std::string("No se pudo abrir el archivo: ") + error.what();
+    }
+    total.volcar(resultado);
+}
@@ -0,0 +1,250 @@
+/**
+ * @file
+ * @brief Motor `tareas`: lectura concurrente de archivo y cómputo de histograma de edades con OpenMP tasks.
+ *
+ * Este motor (`--motor=tareas`) ilustra un patrón productor–consumidor usando **OpenMP tasks**:
+ * un hilo proyecta en memoria el archivo de entrada (CSV o texto simple, una persona por línea) y crea
+ * una tarea por rango de líneas; todos los hilos consumen esas tareas para calcular la edad (vía
+ * `edad::Calculadora`) y actualizar un histograma de 0..130 años (por hilo, por tarea o atómico compartido).
+ *
+ * ## Idea general
+ * - Se inicializa un @ref histograma "histograma" de 131 contadores (0..130) en la variante de `--histograma`.
+ * - En una región paralela, una sección `single` proyecta el archivo con `mmap` (`edad::ArchivoMapeado`),
+ *   la recorre en rangos de `--tarea-kib` alineados a '\n' (`edad::siguiente_rango`) y, por cada rango, crea una
+ *   `#pragma omp task` que recorre sus líneas en bloques de `edad::LINEAS_POR_BLOQUE` y:
+ *   - Clasifica cada bloque con una `edad::Calculadora` compartida (fecha de referencia resuelta una vez;
+ *     parseo y conversión a días vectorizados) sobre vistas a la proyección, sin copiar líneas.
+ *   - Trunca a entero y, si está en rango [0,130], incrementa el contador correspondiente (del hilo, de la
+ *     tarea o el atómico compartido).
+ * - Al final, se imprime de forma determinística cada edad con ocurrencias > 0.
+ * - Con `--agregacion=fechas` cada tarea solo cuenta ocurrencias por fecha en el `edad::ConteoFechas` del
+ *   `edad::Acumulador` del hilo que la ejecuta; la edad se calcula una vez por fecha distinta al final (ver Agregacion.h).
+ *
+ * ## Concurrencia y orden de memoria
+ * - Por omisión (`--histograma=hilos`) cada hilo cuenta en su propio arreglo, sin atómicos; los arreglos se suman
+ *   tras la región paralela. `--histograma=reduccion` logra lo mismo con una reducción de OpenMP
+ *   (`declare reduction` + `task_reduction`/`in_reduction`).
+ * - Las variantes atómicas (`atomico`, `atomico-relleno`) usan `std::memory_order_relaxed`, válido porque cada
+ *   índice del histograma es independiente y solo necesitamos suma atómica sin orden global.
+ *
+ * ## Rendimiento
+ * - **Contadores**: con el arreglo atómico contiguo (`atomico`), 16 edades comparten línea de caché y cada
+ *   `fetch_add` la hace rebotar entre núcleos; con datos sesgados (18–40 años) eso anula gran parte de la
+ *   aceleración. `atomico-relleno` separa las edades en líneas propias (quita el *false sharing*, no la
+ *   contención por edad); `hilos` y `reduccion` no comparten nada por línea.
+ * - **Granularidad de tasks**: una tarea por rango de `--tarea-kib` KiB (1 MiB por omisión, ~100 mil líneas
+ *   de fecha): miles de tareas equilibran la carga sin que su creación pese; dentro de cada tarea el parseo SIMD
+ *   trabaja sobre bloques de `edad::LINEAS_POR_BLOQUE` líneas y no una llamada por línea.
+ * - **Memoria acotada**: los rangos se cortan a medida que se crean las tareas (no hay lista de rangos), hay
+ *   como máximo `TAREAS_EN_VUELO_POR_HILO` tareas pendientes por hilo y cada tarea descarta de la proyección
+ *   las páginas que ya recorrió (`edad::ArchivoMapeado::liberar`). El RSS queda en unos pocos MiB por hilo
+ *   aunque el archivo tenga miles de millones de líneas.
+ * - **Lectura paralela**: cada tarea recorre su propio rango de la proyección, por lo que la lectura escala
+ *   con los hilos (hasta el límite de la *page cache*) en lugar de depender de un único `std::getline`.
+ * - **Entrada `.xz`**: se descomprime en streaming (`edad::LectorXz`); un hilo descompresor llena búferes de
+ *   líneas completas y cada búfer lleno es una tarea, así el parseo se solapa con la descompresión. Si el
+ *   `.xz` tiene varios bloques (ver `recomprimir`), los bloques se decodifican en paralelo.
+ *
+ * @par Ejecución (ejemplos)
+ * @code{.bash}
+ * OMP_NUM_THREADS=8 ./paralelo --motor=tareas datos.csv
+ * OMP_NUM_THREADS=8 ./paralelo --motor=tareas --histograma=atomico datos.csv   # contadores atómicos compartidos (comparación)
+ * ./paralelo --motor=tareas --tarea-kib=256 datos.csv   # tareas más finas (mejor balance con muchos hilos)
+ * @endcode
+ *
+ * @par Formato de entrada esperado
+ * El programa lee el archivo línea a línea. Cada línea debe contener la información suficiente
+ * para que `edad::Calculadora` pueda obtener una edad (por ejemplo, un CSV con una columna de fecha).
+ * Si una línea es inválida (incluidas las vacías) o su edad cae fuera de [0,130], se descarta y se
+ * contabiliza; ambos totales se informan por @c stderr al finalizar.
+ *
+ * @par Ejemplo de líneas (sugerencia)
+ * @code
+ * 2004-11-01
+ * 2005-01-06
+ * @endcode
+ *
+ * @see edad::contar_tareas
+ */
+
+
+#include "Motor.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <omp.h>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "LectorXz.h"
+
+/// Tareas creadas y aún no terminadas por hilo, al recorrer un archivo proyectado: acota la memoria en uso.
+constexpr std::size_t TAREAS_EN_VUELO_POR_HILO = 4u;
+
+/// Contador atómico en su propia línea de caché (`--histograma=atomico-relleno`): dos edades nunca comparten línea.
+struct alignas(64) ContadorRelleno {
+    std::atomic<int> valor{0};
+};
+
+/// Acumulador de un hilo, alineado para que dos hilos no compartan línea de caché en los bordes.
+struct alignas(64) AcumuladorHilo {
+    edad::Acumulador acumulador;
+};
+
+/// Reducción de OpenMP sobre histogramas completos (`--histograma=reduccion`): cada tarea suma en una copia privada.
+#pragma omp declare reduction(suma_histograma : edad::Histograma : edad::sumar_histograma(omp_out, omp_in)) \
+    initializer(omp_priv = edad::Histograma{})
+
+/**
+ * @details
+ * - Una región paralela con una sección `single` que proyecta el archivo (o lo descomprime) y crea una
+ *   @c task por rango de líneas; todos los hilos ejecutan tareas.
+ * - Espera la finalización de tareas y vuelca los acumuladores por hilo y el histograma de `--histograma`.
+ *
+ * @par Seguridad en hilos
+ * - Los acumuladores por hilo los toca solo su hilo (tareas `tied`); las copias de la reducción, solo su tarea.
+ * - Las variantes atómicas usan operaciones relajadas por independencia de celdas.
+ */
+void edad::contar_tareas(const Opciones& opciones, const std::vector<Calculadora>& calculadoras, Resultado& resultado) {
+    const std::string ruta = opciones.ruta;
+
+    /**
+     * @brief Histograma global de edades (0..130), en la variante de `--histograma`.
+     *
+     * Cada índice representa una edad entera (años cumplidos por truncamiento de edad decimal).
+     * - `atomico`: 131 contadores @c std::atomic<int> contiguos; cada `fetch_add` hace rebotar entre núcleos
+     *   la línea de caché que comparte con otras 15 edades (las frecuentes, 18–40, caen en 2 o 3 líneas).
+     * - `atomico-relleno`: un contador atómico por línea de caché; sin *false sharing*, pero cada edad
+     *   frecuente sigue siendo una línea disputada por todos los hilos.
+     * - `hilos`: el histograma del @ref edad::Acumulador de cada hilo (índice omp_get_thread_num(), tareas `tied`),
+     *   sumados al final.
+     * - `reduccion`: cada tarea suma en una copia privada que OpenMP combina al cerrar el `taskgroup`.
+     *
+     * @invariant @c histograma.size() == 131
+     * @thread_safety Seguro para acceso concurrente mediante @c fetch_add y @c load.
+     */
+    const ModoHistograma modo_histograma = opciones.histograma;
+    std::array<std::atomic<int>, 131> histograma;
+    for (std::size_t i = 0u; i < histograma.size(); ++i) {
+        histograma[i].store(0, std::memory_order_relaxed);
+    }
+    std::array<ContadorRelleno, 131> histograma_relleno;
+    Histograma reducido{};
+
+    /// Un acumulador por hilo (descartes, histograma `hilos` y conteo por fecha). Las tareas son `tied`, así que el
+    /// índice omp_get_thread_num() no cambia durante una tarea y dos tareas nunca comparten acumulador a la vez.
+    const bool por_fechas = opciones.agregacion == ModoAgregacion::fechas;
+    std::vector<AcumuladorHilo> acumuladores(static_cast<std::size_t> (omp_get_max_threads()),
+            AcumuladorHilo{Acumulador(calculadoras, por_fechas)});
+
+    /**
+     * @brief Clasifica todas las líneas de @p rango y acumula el resultado (cuerpo de cada task).
+     * @details Vistas directas sobre el texto (proyección o búfer descomprimido): sin copias ni memoria
+     *          dinámica por línea. Thread-safe: solo toca atómicos, el acumulador del hilo que la ejecuta y
+     *          @p privado (la copia de la reducción propia de la tarea).
+     */
+    auto procesar_rango = [&](std::string_view rango, Histograma& privado) {
+        Acumulador& acumulador = acumuladores[static_cast<std::size_t> (omp_get_thread_num())].acumulador;
+        switch (modo_histograma) {
+            case ModoHistograma::atomico:
+                acumulador.procesar_rango(rango, [&histograma](int clave) {
+                    // Un contador independiente por edad -> relaxed está perfecto
+                    histograma[static_cast<std::size_t> (clave)].fetch_add(1, std::memory_order_relaxed);
+                });
+                break;
+            case ModoHistograma::atomico_relleno:
+                acumulador.procesar_rango(rango, [&histograma_relleno](int clave) {
+                    histograma_relleno[static_cast<std::size_t> (clave)].valor.fetch_add(1, std::memory_order_relaxed);
+                });
+                break;
+            case ModoHistograma::reduccion:
+                acumulador.procesar_rango(rango, [&privado](int clave) {
+                    ++privado[static_cast<std::size_t> (clave)];
+                });
+                break;
+            default:
+                acumulador.procesar_rango(rango);
+                break;
+        }
+    };
+
+    // Región paralela: un hilo reparte el archivo en tasks (rangos de la proyección o búferes descomprimidos);
+    // todos consumen tasks
+#pragma omp parallel default(none) shared(ruta, opciones, procesar_rango, reducido, resultado)
+    {
+#pragma omp single
+        {
+            // Todas las tareas participan de la reducción; solo en modo `reduccion` acumulan en su copia privada.
+            // El taskgroup espera a todas sus tareas y recién entonces combina las copias en 'reducido'.
+#pragma omp taskgroup task_reduction(suma_histograma : reducido)
+            {
+                try {
+                    if (es_flujo(ruta)) {
+                        // Un búfer por hilo más dos: los hilos parsean mientras el o los descompresores llenan el resto.
+                        // Si el .xz tiene varios bloques, se decodifican en paralelo (un hilo descompresor por hilo OpenMP).
+                        const std::size_t hilos = static_cast<std::size_t> (omp_get_num_threads());
+                        LectorXz lector(ruta, hilos + 2u, std::size_t{4} << 20, hilos);
+                        std::atomic<std::size_t> en_vuelo{0u};
+                        TrozoXz trozo;
+                        while (lector.tomar(trozo)) {
+                            // Con todos los búferes en tasks, este búfer lo procesa el propio hilo single (tarea no
+                            // diferida): así lo devuelve antes de pedir otro (con un solo hilo, 'tomar' esperaría
+                            // para siempre) y los demás hilos siguen con las tasks pendientes, sin vaciar el pipeline.
+                            const bool diferir = en_vuelo.fetch_add(1u, std::memory_order_relaxed) + 1u < lector.buferes();
+#pragma omp task if(diferir) firstprivate(trozo) shared(lector, en_vuelo, procesar_rango) in_reduction(suma_histograma : reducido)
+                            {
+                                procesar_rango(trozo.texto, reducido);
+                                lector.devolver(trozo);
+                                en_vuelo.fetch_sub(1u, std::memory_order_relaxed);
+                            } // task
+                        }
+#pragma omp taskwait
+                        if (!lector.error().empty()) {
+                            resultado.error = "No se pudo leer el archivo: " + ruta + ": " + lector.error();
+                        }
+                    } else {
+                        const ArchivoMapeado archivo(ruta, opciones.paginas_grandes);
+                        const std::size_t bytes = opciones.kib_por_tarea * 1024u;
+                        const std::size_t limite = TAREAS_EN_VUELO_POR_HILO * static_cast<std::size_t> (omp_get_num_threads());
+                        std::atomic<std::size_t> en_vuelo{0u};
+                        std::string_view resto = archivo.contenido();
+                        while (!resto.empty()) {
+                            const std::string_view rango = siguiente_rango(resto, bytes);
+                            // Sin tope, el hilo single crearía una tarea por rango del archivo completo. Al llegar a él
+                            // procesa el rango él mismo (tarea no diferida) en lugar de esperar con taskwait a que
+                            // terminen todas: los demás hilos siguen con las pendientes y, al volver, crea otra en
+                            // cuanto alguna termina.
+                            const bool diferir = en_vuelo.fetch_add(1u, std::memory_order_relaxed) + 1u < limite;
+#pragma omp task if(diferir) firstprivate(rango) shared(archivo, en_vuelo, procesar_rango) in_reduction(suma_histograma : reducido)
+                            {
+                                procesar_rango(rango, reducido);
+                                // Páginas ya recorridas fuera del RSS: la memoria no crece con el archivo.
+                                archivo.liberar(rango);
+                                en_vuelo.fetch_sub(1u, std::memory_order_relaxed);
+                            } // task
+                        }
+
+                        // La proyección debe seguir viva mientras haya tareas leyendo de ella.
+#pragma omp taskwait
+                    }
+                } catch (const std::runtime_error& error) {
+                    resultado.error = std::string("No se pudo abrir el archivo: ") + error.what();
+                }
+            } // taskgroup
+        } // single
+    } // parallel
+
+    // Todas las variantes terminan en el mismo arreglo: la salida no depende de --histograma.
+    for (const AcumuladorHilo& propio : acumuladores) {
+        propio.acumulador.volcar(resultado);
+    }
+    sumar_histograma(resultado.histograma, reducido);
+    for (std::size_t indice = 0u; indice < resultado.histograma.size(); ++indice) {
+        resultado.histograma[indice] += static_cast<std::uint64_t> (histograma[indice].load(std::memory_order_relaxed))
+                + static_cast<std::uint64_t> (histograma_relleno[indice].valor.load(std::memory_order_relaxed));
+    }
+}
@@ -0,0 +1,121 @@
+/**
+ * @file
+ * @brief Motor `tbb`: histograma de edades con oneTBB, reparto adaptativo con robo de trabajo sobre el archivo proyectado.
+ *
+ * A diferencia de los motores `cola` (lectores + cola lock-free) y `tareas` (OpenMP tasks creadas por un
+ * hilo `single`), aquí no hay productor: el planificador de TBB reparte el archivo entre sus hilos y los hilos
+ * ociosos roban trabajo a los ocupados.
+ *
+ * ## Idea general
+ * - Archivo sin comprimir: se proyecta con `mmap` (`edad::ArchivoMapeado`) y se recorre con `tbb::parallel_for`
+ *   sobre un `tbb::blocked_range` de **bytes**. El `auto_partitioner` de TBB divide el rango a demanda: empieza con
+ *   pocos trozos grandes por hilo y solo los subdivide cuando otro hilo se queda sin trabajo y roba la mitad
+ *   pendiente. Cada subrango de bytes se convierte en las líneas que empiezan en él (`edad::lineas_en_rango`),
+ *   así ninguna línea se parte ni se cuenta dos veces.
+ * - Entrada `.xz`: `tbb::parallel_pipeline` de dos etapas; la primera (serial) toma búferes de líneas completas de
+ *   `edad::LectorXz` y la segunda (paralela) los clasifica y los devuelve al lector. La cantidad de *tokens* en
+ *   vuelo es la de búferes del lector.
+ * - Cada hilo acumula en su propio `edad::Acumulador`, guardado en un `tbb::enumerable_thread_specific`; al final
+ *   se vuelcan una vez con `combine_each`.
+ *
+ * ## Rendimiento
+ * - **Desbalance**: con un reparto estático, un trozo lento (líneas largas, páginas frías, un núcleo compartido)
+ *   retrasa a todos; con robo de trabajo el resto de los hilos se lleva su parte pendiente.
+ * - **Granularidad**: `--tarea-kib` fija el grano mínimo del `blocked_range` (1 MiB por omisión); por debajo de
+ *   ese tamaño TBB no subdivide.
+ * - **Memoria**: cada subrango descarta de la proyección las páginas que ya recorrió
+ *   (`edad::ArchivoMapeado::liberar`), igual que el motor `tareas`.
+ * - **Hilos**: los de `OMP_NUM_THREADS` (como el resto de los motores), mediante un `tbb::task_arena` de ese tamaño;
+ *   a diferencia de OpenMP, TBB no sobresuscribe: nunca más hilos que núcleos disponibles.
+ *
+ * @par Ejecución (ejemplos)
+ * @code{.bash}
+ * ./paralelo --motor=tbb datos.csv
+ * ./paralelo --motor=tbb --tarea-kib=256 datos.csv      # grano mínimo más fino
+ * OMP_NUM_THREADS=8 ./paralelo --motor=tbb edades.csv.xz   # pipeline sobre el .xz descomprimido en streaming
+ * @endcode
+ *
+ * @see edad::contar_tbb
+ */
+
+#include "Motor.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <omp.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/info.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_pipeline.h>
+#include <tbb/task_arena.h>
+
+#include "LectorXz.h"
+
+/**
+ * @details
+ * @par Seguridad en hilos
+ * Cada acumulador lo toca solo el hilo dueño (`enumerable_thread_specific::local`); el asignador por omisión de
+ * TBB alinea cada copia a línea de caché, así que no hay *false sharing* entre hilos.
+ */
+void edad::contar_tbb(const Opciones& opciones, const std::vector<Calculadora>& calculadoras, Resultado& resultado) {
+    const std::string ruta = opciones.ruta;
+    const bool por_fechas = opciones.agregacion == ModoAgregacion::fechas;
+
+    /// Un acumulador por hilo, creado en su primer uso.
+    tbb::enumerable_thread_specific<Acumulador> acumuladores([&calculadoras, por_fechas]() {
+        return Acumulador(calculadoras, por_fechas);
+    });
+
+    // TBB no crea más trabajadores que núcleos (pedir más solo emite un aviso): se acota a ambos límites.
+    const int hilos = std::min(omp_get_max_threads(), tbb::info::default_concurrency());
+    tbb::task_arena arena(hilos);
+    try {
+        if (es_flujo(ruta)) {
+            // Un búfer por hilo más dos, como en 'tareas': los hilos clasifican mientras el lector llena el resto.
+            LectorXz lector(ruta, static_cast<std::size_t> (hilos) + 2u, std::size_t{4} << 20, static_cast<std::size_t> (hilos));
+            arena.execute([&]() {
+                tbb::parallel_pipeline(lector.buferes(),
+                        tbb::make_filter<void, TrozoXz>(tbb::filter_mode::serial_in_order,
+                        [&lector](tbb::flow_control& control) {
+                            TrozoXz trozo;
+                            if (!lector.tomar(trozo)) {
+                                control.stop();
+                            }
+                            return trozo;
+                        }) &
+                        tbb::make_filter<TrozoXz, void>(tbb::filter_mode::parallel,
+                        [&lector, &acumuladores](const TrozoXz& trozo) {
+                            acumuladores.local().procesar_rango(trozo.texto);
+                            lector.devolver(trozo);
+                        }));
+            });
+            if (!lector.error().empty()) {
+                resultado.error = "No se pudo leer el archivo: " + ruta + ": " + lector.error();
+            }
+        } else {
+            const ArchivoMapeado archivo(ruta, opciones.paginas_grandes);
+            const std::string_view texto = archivo.contenido();
+            const std::size_t grano = opciones.kib_por_tarea * 1024u;
+            arena.execute([&]() {
+                tbb::parallel_for(tbb::blocked_range<std::size_t>(0u, texto.size(), grano),
+                        [&archivo, texto, &acumuladores](const tbb::blocked_range<std::size_t>& bytes) {
+                            const std::string_view rango = lineas_en_rango(texto, bytes.begin(), bytes.end());
+                            acumuladores.local().procesar_rango(rango);
+                            archivo.liberar(rango);
+                        });
+            });
+        }
+    } catch (const std::runtime_error& error) {
+        resultado.error = std::string("No se pudo abrir el archivo: ") + error.what();
+    }
+
+    acumuladores.combine_each([&resultado](const Acumulador& acumulador) {
+        acumulador.volcar(resultado);
+    });
+}
@@ -0,0 +1,181 @@
+#include "Numa.h"
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iomanip>
+#include <thread>
+
+namespace {
+
+    const char* const DIRECTORIO_NODOS = "/sys/devices/system/node/";
+
+    /// Primera línea de @p ruta (vacía si no se pudo leer).
+    std::string leer_linea(const std::string& ruta) {
+        std::ifstream archivo(ruta);
+        std::string linea;
+        std::getline(archivo, linea);
+        return linea;
+    }
+
+    /// Núcleos de la afinidad del proceso, en orden creciente; si el kernel no la informa, los `hardware_concurrency` primeros.
+    std::vector<int> cpus_permitidas() {
+        cpu_set_t conjunto;
+        CPU_ZERO(&conjunto);
+        std::vector<int> cpus;
+        if (::sched_getaffinity(0, sizeof (conjunto), &conjunto) == 0) {
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+                if (CPU_ISSET(cpu, &conjunto)) {
+                    cpus.push_back(cpu);
+                }
+            }
+        }
+        if (cpus.empty()) {
+            const int cantidad = std::max(1, static_cast<int> (std::thread::hardware_concurrency()));
+            for (int cpu = 0; cpu < cantidad && cpu < CPU_SETSIZE; ++cpu) {
+                cpus.push_back(cpu);
+            }
+        }
+        return cpus;
+    }
+
+    /// @p cpus (en orden creciente) como lista de sysfs: `"0-3,8"`.
+    std::string formatear_lista_cpus(const std::vector<int>& cpus) {
+        std::string texto;
+        for (std::size_t i = 0u; i < cpus.size();) {
+            std::size_t fin = i + 1u;
+            while (fin < cpus.size() && cpus[fin] == cpus[fin - 1u] + 1) {
+                ++fin;
+            }
+            if (!texto.empty()) {
+                texto += ',';
+            }
+            texto += std::to_string(cpus[i]);
+            if (fin - i > 1u) {
+                texto += '-' + std::to_string(cpus[fin - 1u]);
+            }
+            i = fin;
+        }
+        return texto;
+    }
+}
+
+std::vector<int> edad::parsear_lista_cpus(const std::string& texto) {
+    std::vector<int> cpus;
+    std::size_t posicion = 0u;
+    auto numero = [&texto, &posicion](int& valor) {
+        if (posicion >= texto.size() || !std::isdigit(static_cast<unsigned char> (texto[posicion]))) {
+            return false;
+        }
+        valor = 0;
+        while (posicion < texto.size() && std::isdigit(static_cast<unsigned char> (texto[posicion]))) {
+            valor = valor * 10 + (texto[posicion] - '0');
+            if (valor >= CPU_SETSIZE) {
+                return false;
+            }
+            ++posicion;
+        }
+        return true;
+    };
+    while (posicion < texto.size() && texto[posicion] != '\n') {
+        int desde;
+        if (!numero(desde)) {
+            return {};
+        }
+        int hasta = desde;
+        if (posicion < texto.size() && texto[posicion] == '-') {
+            ++posicion;
+            if (!numero(hasta) || hasta < desde) {
+                return {};
+            }
+        }
+        for (int cpu = desde; cpu <= hasta; ++cpu) {
+            cpus.push_back(cpu);
+        }
+        if (posicion < texto.size() && texto[posicion] == ',') {
+            ++posicion;
+        }
+    }
+    return cpus;
+}
+
+std::vector<edad::NodoNuma> edad::leer_topologia_numa() {
+    std::vector<int> permitidas = cpus_permitidas();
+    std::vector<NodoNuma> nodos;
+    for (const int id : parsear_lista_cpus(leer_linea(std::string(DIRECTORIO_NODOS) + "online"))) {
+        NodoNuma nodo;
+        nodo.id = id;
+        for (const int cpu : parsear_lista_cpus(leer_linea(std::string(DIRECTORIO_NODOS) + "node" + std::to_string(id) + "/cpulist"))) {
+            if (std::binary_search(permitidas.begin(), permitidas.end(), cpu)) {
+                nodo.cpus.push_back(cpu);
+            }
+        }
+        if (!nodo.cpus.empty()) {
+            std::sort(nodo.cpus.begin(), nodo.cpus.end());
+            nodos.push_back(std::move(nodo));
+        }
+    }
+    if (nodos.empty()) {
+        // Sin sysfs (contenedores, otros núcleos): un solo nodo con toda la afinidad.
+        NodoNuma nodo;
+        nodo.cpus = std::move(permitidas);
+        nodos.push_back(std::move(nodo));
+    }
+    return nodos;
+}
+
+std::vector<edad::PuestoNuma> edad::asignar_hilos_numa(const std::vector<NodoNuma>& nodos, std::size_t hilos) {
+    std::vector<PuestoNuma> orden;
+    for (std::size_t ronda = 0u;; ++ronda) {
+        const std::size_t antes = orden.size();
+        for (std::size_t nodo = 0u; nodo < nodos.size(); ++nodo) {
+            if (ronda < nodos[nodo].cpus.size()) {
+                orden.push_back(PuestoNuma{nodo, nodos[nodo].cpus[ronda]});
+            }
+        }
+        if (orden.size() == antes) {
+            break;
+        }
+    }
+    std::vector<PuestoNuma> puestos;
+    puestos.reserve(hilos);
+    for (std::size_t hilo = 0u; hilo < hilos && !orden.empty(); ++hilo) {
+        puestos.push_back(orden[hilo % orden.size()]);
+    }
+    return puestos;
+}
+
+bool edad::fijar_hilo(int cpu, cpu_set_t& anterior) noexcept {
+    if (::sched_getaffinity(0, sizeof (anterior), &anterior) != 0) {
+        return false;
+    }
+    cpu_set_t conjunto;
+    CPU_ZERO(&conjunto);
+    CPU_SET(cpu, &conjunto);
+    return ::sched_setaffinity(0, sizeof (conjunto), &conjunto) == 0;
+}
+
+void edad::restaurar_afinidad(const cpu_set_t& anterior) noexcept {
+    ::sched_setaffinity(0, sizeof (anterior), &anterior);
+}
+
+void edad::imprimir_metricas_numa(const std::vector<NodoNuma>& nodos, const std::vector<MetricasNodo>& metricas, std::ostream& salida) {
+    const std::ios::fmtflags banderas = salida.flags();
+    const std::streamsize precision = salida.precision();
+    salida << std::fixed;
+    for (std::size_t indice = 0u; indice < nodos.size() && indice < metricas.size(); ++indice) {
+        const MetricasNodo& propias = metricas[indice];
+        if (propias.hilos == 0u) {
+            continue;
+        }
+        const double mib = static_cast<double> (propias.bytes) / (1024.0 * 1024.0);
+        const double segundos = static_cast<double> (propias.ns) / 1e9;
+        salida << "Nodo " << nodos[indice].id << " (CPU " << formatear_lista_cpus(nodos[indice].cpus) << ", "
+                << propias.hilos << (propias.hilos == 1u ? " hilo" : " hilos") << "): "
+                << std::setprecision(1) << mib << " MiB en " << std::setprecision(3) << segundos << " s, "
+                << std::setprecision(1) << (segundos > 0.0 ? mib / segundos : 0.0) << " MiB/s ("
+                << static_cast<double> (propias.bytes_ajenos) / (1024.0 * 1024.0) << " MiB de otros nodos)\n";
+    }
+    salida.flags(banderas);
+    salida.precision(precision);
+}
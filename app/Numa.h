@@ -0,0 +1,92 @@
+#ifndef NUMA_H
+#define NUMA_H
+
+/**
+ * @file Numa.h
+ * @brief Topología NUMA del equipo (leída de sysfs) y fijación de hilos a núcleos.
+ *
+ * @details
+ * En un equipo de varios zócalos cada nodo NUMA tiene su memoria; un hilo que lee páginas de otro nodo paga un
+ * acceso remoto (más latencia, ancho de banda compartido por la interconexión). Linux ubica cada página en el nodo
+ * del hilo que la toca por primera vez (*first touch*), incluidas las de la *page cache* al leerse de disco, así que
+ * basta con que cada porción de la entrada la recorran solo hilos fijados a un mismo nodo.
+ *
+ * La topología se lee de `/sys/devices/system/node/node<N>/cpulist` (sin depender de libnuma) y se restringe a los
+ * núcleos de la afinidad del proceso (`taskset`, cgroups). Sin sysfs, o en un equipo de un solo nodo, se informa
+ * un único nodo con todos los núcleos permitidos.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <sched.h>
+
+namespace edad {
+
+    /**
+     * @brief Un nodo NUMA y los núcleos permitidos al proceso que le pertenecen.
+     */
+    struct NodoNuma {
+        int id = 0; ///< Número de nodo del kernel.
+        std::vector<int> cpus; ///< Núcleos del nodo en la afinidad del proceso, en orden creciente (no vacío).
+    };
+
+    /**
+     * @brief Nodos NUMA con al menos un núcleo permitido, en orden de número de nodo (nunca vacío).
+     */
+    std::vector<NodoNuma> leer_topologia_numa();
+
+    /**
+     * @brief Interpreta una lista de núcleos de sysfs (`"0-3,8,10-11"`).
+     * @return Los núcleos, en el orden de la lista; vacío si el texto no es válido.
+     */
+    std::vector<int> parsear_lista_cpus(const std::string& texto);
+
+    /**
+     * @brief Núcleo asignado a un hilo y el nodo al que pertenece.
+     */
+    struct PuestoNuma {
+        std::size_t nodo = 0u; ///< Índice en el vector de @ref leer_topologia_numa (no el número de nodo del kernel).
+        int cpu = 0;
+    };
+
+    /**
+     * @brief Asigna @p hilos hilos a los núcleos de @p nodos, intercalando nodos.
+     *
+     * @details Se toma el primer núcleo de cada nodo, luego el segundo de cada uno, y así: con menos hilos que
+     *          núcleos todos los nodos (y sus controladores de memoria) reciben hilos. Con más hilos que núcleos la
+     *          asignación vuelve a empezar.
+     * @return Un puesto por hilo, en orden de número de hilo.
+     */
+    std::vector<PuestoNuma> asignar_hilos_numa(const std::vector<NodoNuma>& nodos, std::size_t hilos);
+
+    /**
+     * @brief Fija el hilo que llama a @p cpu y guarda en @p anterior su afinidad previa.
+     * @return `false` si el kernel rechazó el cambio (p. ej. núcleo fuera del cgroup); el hilo sigue como estaba.
+     */
+    bool fijar_hilo(int cpu, cpu_set_t& anterior) noexcept;
+
+    /// Restaura en el hilo que llama la afinidad @p anterior guardada por @ref fijar_hilo.
+    void restaurar_afinidad(const cpu_set_t& anterior) noexcept;
+
+    /**
+     * @brief Trabajo de un nodo en una ejecución.
+     */
+    struct MetricasNodo {
+        std::size_t hilos = 0u; ///< Hilos fijados a núcleos del nodo.
+        std::uint64_t bytes = 0u; ///< Bytes de texto clasificados por esos hilos.
+        std::uint64_t bytes_ajenos = 0u; ///< De ellos, los tomados de la porción de otro nodo.
+        std::uint64_t ns = 0u; ///< Desde el inicio hasta que terminó el último hilo del nodo.
+    };
+
+    /**
+     * @brief Imprime una línea por nodo con hilos: núcleos, MiB clasificados, tiempo y MiB/s.
+     * @param metricas Una por elemento de @p nodos.
+     */
+    void imprimir_metricas_numa(const std::vector<NodoNuma>& nodos, const std::vector<MetricasNodo>& metricas, std::ostream& salida);
+}
+
+#endif /* NUMA_H */
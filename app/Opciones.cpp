@@ -0,0 +1,327 @@
+#include "Opciones.h"
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+namespace {
+
+    /// Retorna el valor de `--nombre=valor` si @p argumento corresponde a la opción @p prefijo.
+    bool valor_opcion(const std::string& argumento, const std::string& prefijo, std::string& valor) {
+        if (argumento.compare(0, prefijo.size(), prefijo) != 0) {
+            return false;
+        }
+        valor = argumento.substr(prefijo.size());
+        return true;
+    }
+
+    /**
+     * @brief Interpreta @p valor como entero en [@p minimo, @p maximo] y lo guarda en @p destino.
+     * @details Rechaza texto vacío, negativos, caracteres sobrantes y valores fuera de rango, informando por @c std::cerr
+     *          "<error>: <valor> (se espera <minimo> a <maximo><unidad>)".
+     */
+    bool leer_natural(const std::string& valor, unsigned long long minimo, unsigned long long maximo, const char* error,
+            const char* unidad, std::size_t& destino) {
+        std::size_t usados = 0u;
+        unsigned long long numero = 0u;
+        try {
+            numero = std::stoull(valor, &usados);
+        } catch (const std::exception&) {
+            usados = 0u;
+        }
+        if (usados == 0u || usados != valor.size() || valor[0] == '-' || numero < minimo || numero > maximo) {
+            std::cerr << error << ": " << valor << " (se espera " << minimo << " a " << maximo << unidad << ")\n";
+            return false;
+        }
+        destino = static_cast<std::size_t> (numero);
+        return true;
+    }
+
+    /// Indica si el motor @p motor implementa la estructura de histograma @p histograma.
+    bool histograma_admitido(edad::Motor motor, edad::ModoHistograma histograma) {
+        switch (histograma) {
+            case edad::ModoHistograma::hilos:
+                return true;
+            case edad::ModoHistograma::mapa:
+                return motor == edad::Motor::cola;
+            case edad::ModoHistograma::atomico:
+            case edad::ModoHistograma::atomico_relleno:
+            case edad::ModoHistograma::reduccion:
+                return motor == edad::Motor::tareas;
+        }
+        return false;
+    }
+
+    /// Interpreta una fecha ISO para `--as-of`; informa el problema por @c std::cerr.
+    bool parsear_referencia(const std::string& texto, long long& dias) {
+        edad::Fecha fecha;
+        const edad::ErrorFecha error = edad::parsear_fecha(texto, fecha);
+        if (error != edad::ErrorFecha::ninguno) {
+            std::cerr << "Fecha de referencia inválida: " << texto << " (" << edad::descripcion(error) << ")\n";
+            return false;
+        }
+        dias = edad::fecha_a_dias(fecha.anio, fecha.mes, fecha.dia);
+        return true;
+    }
+
+    /// Agrega a @p referencias las fechas de un rango `DESDE..HASTA[/Nd|/Nm]`.
+    bool parsear_rango(const std::string& texto, std::vector<long long>& referencias) {
+        const std::size_t puntos = texto.find("..");
+        const std::size_t barra = texto.find('/', puntos);
+        long long desde = 0;
+        long long hasta = 0;
+        if (!parsear_referencia(texto.substr(0, puntos), desde)
+                || !parsear_referencia(texto.substr(puntos + 2u, barra - (puntos + 2u)), hasta)) {
+            return false;
+        }
+
+        long long paso = 1;
+        char unidad = 'd';
+        if (barra != std::string::npos) {
+            const std::string texto_paso = texto.substr(barra + 1u);
+            std::size_t usados = 0u;
+            try {
+                paso = std::stoll(texto_paso, &usados);
+            } catch (const std::exception&) {
+                usados = 0u;
+            }
+            if (usados == 0u || usados + 1u != texto_paso.size() || paso < 1
+                    || (texto_paso.back() != 'd' && texto_paso.back() != 'm')) {
+                std::cerr << "Paso de rango inválido: " << texto_paso << " (se espera Nd o Nm con N >= 1)\n";
+                return false;
+            }
+            unidad = texto_paso.back();
+        }
+        if (desde > hasta) {
+            std::cerr << "Rango de referencia vacío: " << texto << "\n";
+            return false;
+        }
+
+        if (unidad == 'd') {
+            // Se compara el paso con lo que falta antes de sumarlo: `dia + paso` podría desbordar.
+            for (long long dia = desde; referencias.size() <= edad::MAX_REFERENCIAS; dia += paso) {
+                referencias.push_back(dia);
+                if (paso > hasta - dia) {
+                    break;
+                }
+            }
+            return true;
+        }
+
+        // Pasos en meses: se conserva el día (acotado al mes) o, si DESDE es fin de mes, el último día de cada mes.
+        const edad::Fecha inicio = edad::dias_a_fecha(desde);
+        const bool fin_de_mes = inicio.dia == edad::dias_del_mes(inicio.anio, inicio.mes);
+        // Meses entre DESDE y HASTA: ningún desplazamiento mayor cae dentro del rango (y así `meses + paso` no desborda).
+        const edad::Fecha fin = edad::dias_a_fecha(hasta);
+        const long long meses_rango = static_cast<long long> (fin.anio - inicio.anio) * 12 + static_cast<long long> (fin.mes) - static_cast<long long> (inicio.mes);
+        for (long long meses = 0;; meses += paso) {
+            const long long indice = static_cast<long long> (inicio.mes) - 1 + meses;
+            const long long anio = inicio.anio + indice / 12;
+            const unsigned mes = static_cast<unsigned> (indice % 12) + 1u;
+            const unsigned ultimo = edad::dias_del_mes(anio, mes);
+            const unsigned dia = fin_de_mes ? ultimo : std::min(inicio.dia, ultimo);
+            const long long referencia = edad::fecha_a_dias(anio, mes, dia);
+            if (referencia > hasta || referencias.size() > edad::MAX_REFERENCIAS) {
+                break;
+            }
+            referencias.push_back(referencia);
+            if (paso > meses_rango - meses) {
+                break;
+            }
+        }
+        return true;
+    }
+
+    /// Interpreta el valor de `--as-of`: lista separada por comas de fechas o rangos.
+    bool parsear_referencias(const std::string& valor, std::vector<long long>& referencias) {
+        referencias.clear();
+        std::size_t inicio = 0u;
+        for (;;) {
+            const std::size_t coma = valor.find(',', inicio);
+            const std::string elemento = valor.substr(inicio, coma - inicio);
+            if (elemento.find("..") != std::string::npos) {
+                if (!parsear_rango(elemento, referencias)) {
+                    return false;
+                }
+            } else {
+                long long dias = 0;
+                if (!parsear_referencia(elemento, dias)) {
+                    return false;
+                }
+                referencias.push_back(dias);
+            }
+            if (referencias.size() > edad::MAX_REFERENCIAS) {
+                std::cerr << "Demasiadas fechas de referencia (máximo " << edad::MAX_REFERENCIAS << ")\n";
+                return false;
+            }
+            if (coma == std::string::npos) {
+                return true;
+            }
+            inicio = coma + 1u;
+        }
+    }
+}
+
+bool edad::parsear_opciones(int argc, char** argv, Opciones& opciones) {
+    bool referencia_fijada = false;
+    for (int i = 1; i < argc; ++i) {
+        const std::string argumento = argv[i];
+        std::string valor;
+        if (valor_opcion(argumento, "--as-of=", valor)) {
+            if (!parsear_referencias(valor, opciones.referencias)) {
+                return false;
+            }
+            referencia_fijada = true;
+        } else if (valor_opcion(argumento, "--modo-edad=", valor)) {
+            if (valor == "promedio") {
+                opciones.modo_edad = edad::ModoEdad::promedio;
+            } else if (valor == "exacta") {
+                opciones.modo_edad = edad::ModoEdad::exacta;
+            } else {
+                std::cerr << "Modo de edad inválido: " << valor << " (se espera promedio o exacta)\n";
+                return false;
+            }
+        } else if (valor_opcion(argumento, "--agregacion=", valor)) {
+            if (valor == "edades") {
+                opciones.agregacion = edad::ModoAgregacion::edades;
+            } else if (valor == "fechas") {
+                opciones.agregacion = edad::ModoAgregacion::fechas;
+            } else {
+                std::cerr << "Agregación inválida: " << valor << " (se espera edades o fechas)\n";
+                return false;
+            }
+        } else if (valor_opcion(argumento, "--conteo-fechas=", valor)) {
+            if (valor.empty()) {
+                std::cerr << "Falta la ruta de --conteo-fechas\n";
+                return false;
+            }
+            opciones.ruta_conteo_fechas = valor;
+        } else if (valor_opcion(argumento, "--lote=", valor)) {
+            if (!leer_natural(valor, 0u, edad::MAX_LINEAS_POR_LOTE, "Tamaño de lote inválido", "", opciones.lineas_por_lote)) {
+                return false;
+            }
+        } else if (valor_opcion(argumento, "--tarea-kib=", valor)) {
+            if (!leer_natural(valor, 1u, edad::MAX_KIB_POR_TAREA, "Tamaño de tarea inválido", " KiB", opciones.kib_por_tarea)) {
+                return false;
+            }
+        } else if (valor_opcion(argumento, "--lectores=", valor)) {
+            if (!leer_natural(valor, 1u, edad::MAX_HILOS_COLA, "Cantidad de lectores inválida", "", opciones.lectores)) {
+                return false;
+            }
+        } else if (valor_opcion(argumento, "--consumidores=", valor)) {
+            if (!leer_natural(valor, 1u, edad::MAX_HILOS_COLA, "Cantidad de consumidores inválida", "", opciones.consumidores)) {
+                return false;
+            }
+        } else if (valor_opcion(argumento, "--marca-alta=", valor)) {
+            if (!leer_natural(valor, 1u, edad::MAX_MARCA_COLA, "Marca alta inválida", " lotes", opciones.marca_alta)) {
+                return false;
+            }
+        } else if (valor_opcion(argumento, "--marca-baja=", valor)) {
+            if (!leer_natural(valor, 1u, edad::MAX_MARCA_COLA, "Marca baja inválida", " lotes", opciones.marca_baja)) {
+                return false;
+            }
+        } else if (argumento == "--autoajuste") {
+            opciones.autoajuste = true;
+        } else if (valor_opcion(argumento, "--cola=", valor)) {
+            if (!edad::parsear_tipo_cola(valor, opciones.cola)) {
+                std::cerr << "Cola inválida: " << valor << " (se espera " << edad::nombres_colas() << ")\n";
+                return false;
+            }
+        } else if (valor_opcion(argumento, "--espera=", valor)) {
+            if (valor == "ceder") {
+                opciones.espera = edad::PoliticaEspera::ceder;
+            } else if (valor == "girar") {
+                opciones.espera = edad::PoliticaEspera::girar;
+            } else if (valor == "adaptativa") {
+                opciones.espera = edad::PoliticaEspera::adaptativa;
+            } else {
+                std::cerr << "Política de espera inválida: " << valor << " (se espera ceder, girar o adaptativa)\n";
+                return false;
+            }
+        } else if (argumento == "--metricas-espera") {
+            opciones.metricas_espera = true;
+        } else if (argumento == "--metricas-numa") {
+            opciones.metricas_numa = true;
+        } else if (argumento == "--metricas-memoria") {
+            opciones.metricas_memoria = true;
+        } else if (valor_opcion(argumento, "--motor=", valor)) {
+            if (valor == "serial") {
+                opciones.motor = edad::Motor::serial;
+            } else if (valor == "tareas") {
+                opciones.motor = edad::Motor::tareas;
+            } else if (valor == "cola") {
+                opciones.motor = edad::Motor::cola;
+            } else if (valor == "bloques") {
+                opciones.motor = edad::Motor::bloques;
+            } else if (valor == "tbb") {
+                opciones.motor = edad::Motor::tbb;
+            } else if (valor == "std-par") {
+                opciones.motor = edad::Motor::std_par;
+            } else if (valor == "numa") {
+                opciones.motor = edad::Motor::numa;
+            } else if (valor == "corrutinas") {
+                opciones.motor = edad::Motor::corrutinas;
+            } else {
+                std::cerr << "Motor inválido: " << valor << " (se espera serial, tareas, cola, bloques, tbb, std-par, numa o corrutinas)\n";
+                return false;
+            }
+        } else if (valor_opcion(argumento, "--histograma=", valor)) {
+            if (valor == "hilos") {
+                opciones.histograma = edad::ModoHistograma::hilos;
+            } else if (valor == "mapa") {
+                opciones.histograma = edad::ModoHistograma::mapa;
+            } else if (valor == "atomico") {
+                opciones.histograma = edad::ModoHistograma::atomico;
+            } else if (valor == "atomico-relleno") {
+                opciones.histograma = edad::ModoHistograma::atomico_relleno;
+            } else if (valor == "reduccion") {
+                opciones.histograma = edad::ModoHistograma::reduccion;
+            } else {
+                std::cerr << "Histograma inválido: " << valor << " (se espera hilos, mapa, atomico, atomico-relleno o reduccion)\n";
+                return false;
+            }
+        } else if (argumento == "--paginas-grandes") {
+            opciones.paginas_grandes = true;
+        } else if (argumento.compare(0, 2, "--") == 0) {
+            std::cerr << "Opción desconocida: " << argumento << "\n";
+            return false;
+        } else if (opciones.ruta.empty()) {
+            opciones.ruta = argumento;
+        } else {
+            std::cerr << "Argumento inesperado: " << argumento << "\n";
+            return false;
+        }
+    }
+
+    if (opciones.ruta.empty()) {
+        std::cerr << "Falta la ruta del archivo a procesar\n";
+        return false;
+    }
+    if (!histograma_admitido(opciones.motor, opciones.histograma)) {
+        std::cerr << "El motor elegido no admite ese --histograma (cola: hilos o mapa; tareas: hilos, atomico, "
+                "atomico-relleno o reduccion; los demás: hilos)\n";
+        return false;
+    }
+    if (opciones.marca_baja != 0u && opciones.marca_alta == 0u) {
+        // Sin marca alta la baja no tiene contra qué validarse (el motor o el autoajuste la reemplazarían).
+        std::cerr << "--marca-baja requiere --marca-alta\n";
+        return false;
+    }
+    if (opciones.marca_alta != 0u && opciones.marca_baja >= opciones.marca_alta) {
+        std::cerr << "La marca baja debe ser menor que la alta\n";
+        return false;
+    }
+    if (!opciones.ruta_conteo_fechas.empty()) {
+        // El conteo por fecha solo existe en la agregación en dos fases.
+        opciones.agregacion = edad::ModoAgregacion::fechas;
+    }
+    if (!referencia_fijada) {
+        // Se consulta el reloj una única vez por ejecución.
+        opciones.referencias.assign(1u, edad::dias_hoy());
+    }
+    if (opciones.referencias.size() > 1u) {
+        // Varias referencias en una pasada: solo la agregación por fecha reutiliza el conteo.
+        opciones.agregacion = edad::ModoAgregacion::fechas;
+    }
+    return true;
+}
@@ -0,0 +1,218 @@
+#ifndef OPCIONES_H
+#define OPCIONES_H
+
+/**
+ * @file Opciones.h
+ * @brief Opciones de línea de comandos compartidas por los ejecutables del taller.
+ *
+ * @details
+ * Sintaxis general:
+ * @code{.bash}
+ * ./programa [--motor=serial|tareas|cola|bloques|tbb|std-par|numa|corrutinas] [--as-of=FECHAS] [--modo-edad=promedio|exacta] [--agregacion=edades|fechas]
+ *            [--conteo-fechas=RUTA] [--paginas-grandes] [--lote=N]
+ *            [--cola=boost|vyukov|anillos|anillos-robo] [--espera=ceder|girar|adaptativa]
+ *            [--metricas-espera] [--histograma=MODO] [--tarea-kib=N] [--metricas-numa] [--metricas-memoria] [--lectores=N]
+ *            [--consumidores=N] [--marca-alta=N] [--marca-baja=N] [--autoajuste] datos.csv
+ * @endcode
+ * - `--motor=serial|tareas|cola|bloques|tbb|std-par|numa|corrutinas`: cómo se reparte el trabajo entre hilos (ver @ref edad::Motor y
+ *   Motor.h). Por omisión `cola`. La salida es idéntica con todos los motores:
+ *   @code{.bash}
+ *   for m in serial tareas cola bloques tbb std-par numa corrutinas; do ./programa --motor=$m --as-of=2025-01-01 datos.csv | md5sum; done
+ *   @endcode
+ * - `--as-of=FECHAS`: fecha(s) de referencia para el cálculo de edades. Por omisión se usa la
+ *   fecha local actual, resuelta una sola vez al iniciar. Fijarla permite ejecuciones reproducibles.
+ *   FECHAS es una lista separada por comas de fechas `YYYY-MM-DD` o rangos `DESDE..HASTA[/paso]`,
+ *   con paso `Nd` (días) o `Nm` (meses); por omisión `1d`. En pasos de meses el día se conserva
+ *   (acotado a los días del mes) y, si DESDE es fin de mes, cada fecha es el último día de su mes:
+ *   @code{.bash}
+ *   ./programa --as-of=2020-01-31..2024-12-31/1m datos.csv   # todos los fines de mes
+ *   ./programa --as-of=2024-06-30,2025-01-01 datos.csv
+ *   @endcode
+ *   Con más de una fecha se hace una sola pasada sobre el archivo y se emite un histograma por fecha
+ *   (implica `--agregacion=fechas`).
+ * - `--modo-edad=promedio|exacta`: criterio de discretización (ver @ref edad::ModoEdad). Por omisión
+ *   `promedio`. Para medir la diferencia de velocidad y de exactitud entre ambos:
+ *   @code{.bash}
+ *   diff <(./programa --as-of=2025-01-01 --modo-edad=promedio datos.csv) \
+ *        <(./programa --as-of=2025-01-01 --modo-edad=exacta datos.csv)
+ *   @endcode
+ * - `--agregacion=edades|fechas`: estrategia de agregación (ver @ref edad::ModoAgregacion). Por omisión `edades`.
+ * - `--conteo-fechas=RUTA`: escribe además el conteo por fecha de nacimiento ("YYYY-MM-DD,N", orden cronológico)
+ *   en RUTA; implica `--agregacion=fechas`.
+ * - `--paginas-grandes`: sugiere páginas grandes (`MADV_HUGEPAGE`) para la proyección del archivo de
+ *   entrada (ver @ref edad::ArchivoMapeado); reduce fallos de TLB donde el kernel lo admite.
+ * - `--lote=N`: líneas por unidad de trabajo en la cola del motor `cola` (ver Lote.h). Por omisión 4096;
+ *   `--lote=0` encola una línea por elemento, copiada a una arena reciclable (modo histórico, para comparar).
+ * - `--cola=boost|vyukov|anillos|anillos-robo`: implementación de la cola del motor `cola` (ver Cola.h y
+ *   `bench_colas`). Por omisión `boost`.
+ * - `--espera=ceder|girar|adaptativa`: cómo esperan en el motor `cola` los consumidores sin trabajo y el productor
+ *   sin lotes libres (ver @ref edad::PoliticaEspera). Por omisión `adaptativa`: girar, ceder y luego dormir
+ *   hasta que haya trabajo, sin ocupar núcleos mientras el lector es el cuello de botella.
+ * - `--metricas-espera`: informa por @c std::cerr el tiempo que cada hilo pasó girando, cediendo y estacionado.
+ * - `--histograma=MODO`: estructura donde se acumula el histograma de edades (ver @ref edad::ModoHistograma).
+ *   El motor `cola` admite `hilos` y `mapa`; `tareas` admite `hilos`, `atomico`, `atomico-relleno` y `reduccion`;
+ *   los demás, solo `hilos`. Por omisión `hilos`; la salida es idéntica en todos los modos.
+ * - `--tarea-kib=N`: KiB de texto por tarea de OpenMP en el motor `tareas` al leer un archivo sin comprimir (1 a
+ *   `MAX_KIB_POR_TAREA`). Por omisión 1024: bloques pequeños equilibran la carga, grandes amortizan la creación
+ *   de tareas. La cantidad de tareas pendientes está acotada, así que el RSS no crece con el tamaño del archivo.
+ *   En `bloques` es el tamaño de cada iteración del `omp for`; en `tbb`, el grano mínimo del reparto adaptativo;
+ *   en `std-par`, el tamaño de cada elemento de la reducción; en `numa`, el de cada bloque de la porción de un nodo;
+ *   en `corrutinas`, el de cada trozo que la etapa de lectura envía a las de análisis.
+ * - `--lectores=N`: hilos que leen el archivo y llenan la cola en el motor `cola` (1 a `MAX_HILOS_COLA`). Por
+ *   omisión 1. Cada lector toma rangos alineados a '\n' del archivo proyectado (o búferes del `.xz`); sirve cuando
+ *   un solo lector no alcanza a los consumidores (página en caché, NVMe).
+ * - `--consumidores=N`: hilos que solo consumen en el motor `cola` (1 a `MAX_HILOS_COLA`). Por omisión
+ *   `OMP_NUM_THREADS` menos los lectores; la región usa `lectores + consumidores` hilos y los lectores también
+ *   consumen al terminar de leer.
+ * - `--metricas-numa`: con el motor `numa`, informa por @c std::cerr los MiB, el tiempo y el caudal de cada nodo
+ *   NUMA (ver MotorNuma.cpp).
+ * - `--metricas-memoria`: informa por @c std::cerr las reservas y liberaciones de memoria dinámica del conteo (ver
+ *   Memoria.h); el motor `cola` las separa en preparación (cola, lotes, estado por hilo), régimen y cierre, y con `--lote=0`
+ *   informa además las losas de la arena de líneas (ver Arena.h).
+ * - `--marca-alta=N`, `--marca-baja=N`: marcas de agua del motor `cola`, en lotes llenos esperando en la cola (1 a
+ *   `MAX_MARCA_COLA`; la baja, menor que la alta). Al llegar a la alta el lector deja de llenar y consume hasta
+ *   bajar a la baja. Sin `--marca-alta` no hay marcas (el lector solo consume si no hay lotes libres); la baja es
+ *   por omisión la mitad de la alta y solo se acepta junto con `--marca-alta`. No se usan con `--lote=0`.
+ * - `--autoajuste`: en el motor `cola` con lotes, ajusta durante la ejecución el tamaño de lote y las marcas de
+ *   agua según la ocupación de la cola, los reintentos de los lectores y los vaciamientos de los consumidores, e
+ *   informa por @c std::cerr el ajuste al que convergió, listo para fijarlo con `--lote` y `--marca-*` (ver
+ *   Autoajuste.h). Parte de los valores dados (o de todos los lotes como marca alta).
+ * - El primer argumento que no comienza con `--` es la ruta del archivo a procesar.
+ */
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "Cola.h"
+#include "Edad.h"
+#include "Espera.h"
+
+namespace edad {
+
+    /// Máximo de fechas de referencia por ejecución (cada una reserva su tabla de edades, ~48 KB).
+    constexpr std::size_t MAX_REFERENCIAS = 4096u;
+
+    /// Máximo de líneas por lote de `--lote` (los desplazamientos dentro del lote son de 32 bits).
+    constexpr std::size_t MAX_LINEAS_POR_LOTE = std::size_t{1} << 20;
+
+    /// Máximo de `--lectores` y de `--consumidores`.
+    constexpr std::size_t MAX_HILOS_COLA = 1024u;
+
+    /// Mayor marca de agua admitida (en lotes; en la ejecución se acota a los lotes del pipeline).
+    constexpr std::size_t MAX_MARCA_COLA = std::size_t{1} << 16;
+
+    /// Máximo de `--tarea-kib` (1 GiB por tarea).
+    constexpr std::size_t MAX_KIB_POR_TAREA = std::size_t{1} << 20;
+
+    /**
+     * @brief Motor de ejecución: cómo se reparte el archivo entre hilos (ver Motor.h).
+     */
+    enum class Motor {
+        serial, ///< Un solo hilo (referencia).
+        tareas, ///< OpenMP tasks por rango, creadas por un hilo `single`.
+        cola, ///< Uno o varios lectores y cola lock-free de lotes hacia los consumidores.
+        bloques, ///< `omp for schedule(dynamic)` sobre bloques de tamaño fijo.
+        tbb, ///< oneTBB: `parallel_for` con robo de trabajo (`parallel_pipeline` para `.xz`).
+        std_par, ///< `std::transform_reduce` con `std::execution::par` sobre rangos de líneas.
+        numa, ///< Hilos fijados a núcleos, una porción del archivo y un acumulador por nodo NUMA.
+        corrutinas ///< Corrutinas de C++20 por etapa (lectura, análisis, agregación) unidas por canales acotados.
+    };
+
+    /**
+     * @brief Estrategia de agregación de las líneas leídas.
+     */
+    enum class ModoAgregacion {
+        edades, ///< Cada línea se clasifica en una edad y se suma al histograma.
+        fechas ///< Se cuentan ocurrencias por fecha y la edad se calcula una vez por fecha distinta (ver Agregacion.h).
+    };
+
+    /**
+     * @brief Estructura donde se acumula el histograma de edades (agregación `edades`).
+     */
+    enum class ModoHistograma {
+        hilos, ///< Un arreglo denso de EDAD_MAXIMA + 1 contadores por hilo, combinados una vez al final.
+        mapa, ///< Motor `cola`: un `concurrent_flat_map` compartido, actualizado por línea (admite claves no acotadas).
+        atomico, ///< Motor `tareas`: un arreglo compartido de contadores atómicos contiguos (16 por línea de caché).
+        atomico_relleno, ///< Motor `tareas`: contadores atómicos compartidos, cada uno en su propia línea de caché.
+        reduccion ///< Motor `tareas`: reducción de OpenMP (`declare reduction` + `task_reduction`) sobre copias por tarea.
+    };
+
+    /**
+     * @brief Configuración de una ejecución.
+     */
+    struct Opciones {
+        /// Ruta del archivo de entrada.
+        std::string ruta;
+
+        /// Motor de ejecución.
+        Motor motor = Motor::cola;
+
+        /// Días de referencia (según @ref fecha_a_dias) usados para calcular edades, en el orden dado; al menos uno.
+        std::vector<long long> referencias;
+
+        /// Criterio de discretización de la edad.
+        ModoEdad modo_edad = ModoEdad::promedio;
+
+        /// Estrategia de agregación.
+        ModoAgregacion agregacion = ModoAgregacion::edades;
+
+        /// Ruta donde escribir el conteo por fecha (vacía: no se escribe).
+        std::string ruta_conteo_fechas;
+
+        /// Sugerir páginas grandes para la proyección del archivo de entrada.
+        bool paginas_grandes = false;
+
+        /// Líneas por unidad de trabajo encolada (0: una línea por elemento).
+        std::size_t lineas_por_lote = 4096u;
+
+        /// Implementación de la cola productor–consumidor.
+        TipoCola cola = TipoCola::boost;
+
+        /// Política de espera de los hilos sin trabajo.
+        PoliticaEspera espera = PoliticaEspera::adaptativa;
+
+        /// Informar los contadores de espera por hilo.
+        bool metricas_espera = false;
+
+        /// Estructura del histograma de edades.
+        ModoHistograma histograma = ModoHistograma::hilos;
+
+        /// KiB de texto por tarea, bloque o trozo al recorrer un archivo proyectado (todos los motores salvo `serial` y `cola`).
+        std::size_t kib_por_tarea = 1024u;
+
+        /// Hilos lectores del motor `cola` (productores de la cola).
+        std::size_t lectores = 1u;
+
+        /// Hilos solo consumidores del motor `cola` (0: `OMP_NUM_THREADS` menos los lectores).
+        std::size_t consumidores = 0u;
+
+        /// Informar el trabajo y el caudal por nodo NUMA (motor `numa`).
+        bool metricas_numa = false;
+
+        /// Informar las reservas de memoria dinámica del conteo.
+        bool metricas_memoria = false;
+
+        /// Marca alta del motor `cola`, en lotes llenos (0: sin marcas).
+        std::size_t marca_alta = 0u;
+
+        /// Marca baja del motor `cola`, en lotes llenos (0: la mitad de la alta).
+        std::size_t marca_baja = 0u;
+
+        /// Ajustar el tamaño de lote y las marcas durante la ejecución (motor `cola`).
+        bool autoajuste = false;
+    };
+
+    /**
+     * @brief Interpreta los argumentos del programa.
+     *
+     * @param argc Cantidad de argumentos (incluye el nombre del programa).
+     * @param argv Vector de argumentos.
+     * @param opciones Destino de la configuración interpretada.
+     * @return `true` si los argumentos son válidos; en caso contrario informa el problema por
+     *         @c std::cerr y retorna `false`.
+     */
+    bool parsear_opciones(int argc, char** argv, Opciones& opciones);
+}
+
+#endif /* OPCIONES_H */
@@ -0,0 +1,239 @@
+/**
+ * @file
+ * @brief Banco de pruebas: compara las implementaciones de Cola.h con un productor y 1..N consumidores.
+ *
+ * @details
+ * Para cada cola y cada cantidad de consumidores, un productor encola `--elementos` punteros tan rápido como
+ * puede (yield si la cola está llena) y los consumidores los desencolan (yield si no hay). Se informa:
+ * - **Melem/s**: elementos por segundo (millones), desde el inicio del productor hasta el fin del último consumidor.
+ * - **enc/des p50/p99/p999**: percentiles, en nanosegundos, de la duración de cada llamada exitosa a
+ *   @ref edad::Cola::encolar (productor) y @ref edad::Cola::desencolar (consumidores). Se cronometra solo la
+ *   llamada, no el tiempo que el elemento pasa esperando en la cola: con el productor saturando, esa espera
+ *   es capacidad ÷ rendimiento y sería igual para todas las colas. La cola de la distribución muestra
+ *   contención (reintentos de CAS, líneas de caché disputadas). Incluye el costo de leer el reloj (~20 ns).
+ *
+ * La capacidad por omisión (1024) mantiene la cola en caché; `--capacidad=131072` reproduce la del motor `cola`.
+ * Con más consumidores que núcleos la medición refleja sobre todo el costo de ceder la CPU (yield), no la cola.
+ *
+ * ### Uso
+ * @code{.bash}
+ * ./bench_colas [--elementos=N] [--consumidores=MAX] [--capacidad=N] [--colas=boost,vyukov,anillos,anillos-robo]
+ * ./bench_colas --elementos=2000000 --consumidores=8
+ * @endcode
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Cola.h"
+
+namespace {
+
+    using Reloj = std::chrono::steady_clock;
+
+    /// Configuración del banco de pruebas.
+    struct OpcionesBanco {
+        std::size_t elementos = 1000000u;
+        std::size_t consumidores = 0u; ///< 0: núcleos disponibles.
+        std::size_t capacidad = 1024u; ///< Pequeña: se mide la cola, no la caché ni el atraso acumulado.
+        std::vector<edad::TipoCola> colas{edad::TipoCola::boost, edad::TipoCola::vyukov, edad::TipoCola::anillos,
+            edad::TipoCola::anillos_robo};
+    };
+
+    /// Percentiles de duración de llamada, en nanosegundos.
+    struct Percentiles {
+        std::int64_t p50;
+        std::int64_t p99;
+        std::int64_t p999;
+    };
+
+    /// Resultado de una corrida.
+    struct Medicion {
+        double elementos_por_segundo;
+        Percentiles encolar;
+        Percentiles desencolar;
+        std::size_t recibidos;
+    };
+
+    /// Nanosegundos entre @p desde y @p hasta.
+    std::int64_t nanosegundos(Reloj::time_point desde, Reloj::time_point hasta) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds> (hasta - desde).count();
+    }
+
+    /// Interpreta un entero positivo de `--nombre=valor`; informa el problema por @c std::cerr.
+    bool valor_numerico(const std::string& argumento, const std::string& prefijo, std::size_t& valor, bool& coincide) {
+        coincide = argumento.compare(0, prefijo.size(), prefijo) == 0;
+        if (!coincide) {
+            return true;
+        }
+        const std::string texto = argumento.substr(prefijo.size());
+        std::size_t usados = 0u;
+        unsigned long long numero = 0u;
+        try {
+            numero = std::stoull(texto, &usados);
+        } catch (const std::exception&) {
+            usados = 0u;
+        }
+        if (usados == 0u || usados != texto.size() || texto[0] == '-' || numero == 0u) {
+            std::cerr << "Valor inválido en " << argumento << "\n";
+            return false;
+        }
+        valor = static_cast<std::size_t> (numero);
+        return true;
+    }
+
+    bool parsear(int argc, char** argv, OpcionesBanco& opciones) {
+        for (int i = 1; i < argc; ++i) {
+            const std::string argumento = argv[i];
+            bool coincide = false;
+            if (!valor_numerico(argumento, "--elementos=", opciones.elementos, coincide)) {
+                return false;
+            } else if (coincide) {
+                continue;
+            } else if (!valor_numerico(argumento, "--consumidores=", opciones.consumidores, coincide)) {
+                return false;
+            } else if (coincide) {
+                continue;
+            } else if (!valor_numerico(argumento, "--capacidad=", opciones.capacidad, coincide)) {
+                return false;
+            } else if (coincide) {
+                continue;
+            } else if (argumento.compare(0, 8, "--colas=") == 0) {
+                opciones.colas.clear();
+                std::size_t inicio = 8u;
+                for (;;) {
+                    const std::size_t coma = argumento.find(',', inicio);
+                    const std::string nombre = argumento.substr(inicio, coma - inicio);
+                    edad::TipoCola tipo;
+                    if (!edad::parsear_tipo_cola(nombre, tipo)) {
+                        std::cerr << "Cola inválida: " << nombre << " (se espera " << edad::nombres_colas() << ")\n";
+                        return false;
+                    }
+                    opciones.colas.push_back(tipo);
+                    if (coma == std::string::npos) {
+                        break;
+                    }
+                    inicio = coma + 1u;
+                }
+            } else {
+                std::cerr << "Uso: " << argv[0]
+                        << " [--elementos=N] [--consumidores=MAX] [--capacidad=N] [--colas=boost,vyukov,anillos,anillos-robo]\n";
+                return false;
+            }
+        }
+        if (opciones.consumidores == 0u) {
+            opciones.consumidores = std::max(1u, std::thread::hardware_concurrency());
+        }
+        return true;
+    }
+
+    /// Percentil @p fraccion de @p latencias (ordenadas).
+    std::int64_t percentil(const std::vector<std::int64_t>& latencias, double fraccion) {
+        if (latencias.empty()) {
+            return 0;
+        }
+        const std::size_t indice = static_cast<std::size_t> (fraccion * static_cast<double> (latencias.size() - 1u));
+        return latencias[indice];
+    }
+
+    /// Ordena @p latencias y extrae p50, p99 y p999.
+    Percentiles percentiles(std::vector<std::int64_t>& latencias) {
+        std::sort(latencias.begin(), latencias.end());
+        return Percentiles{percentil(latencias, 0.50), percentil(latencias, 0.99), percentil(latencias, 0.999)};
+    }
+
+    /// Una corrida: un productor, @p consumidores consumidores, @p elementos elementos.
+    Medicion medir(edad::TipoCola tipo, std::size_t consumidores, const OpcionesBanco& opciones) {
+        edad::ColaDe<char> cola(edad::crear_cola(tipo, opciones.capacidad, 1u, consumidores));
+        std::vector<char> elementos(opciones.elementos);
+        std::vector<std::int64_t> encolados;
+        encolados.reserve(opciones.elementos);
+        std::vector<std::vector<std::int64_t>> desencolados(consumidores);
+        std::atomic<bool> inicio{false};
+        std::atomic<bool> terminado{false};
+
+        std::vector<std::thread> hilos;
+        hilos.reserve(consumidores);
+        for (std::size_t c = 0u; c < consumidores; ++c) {
+            hilos.emplace_back([&, c]() {
+                std::vector<std::int64_t>& propias = desencolados[c];
+                propias.reserve(2u * opciones.elementos / consumidores + 1u);
+                while (!inicio.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+                for (;;) {
+                    char* elemento = nullptr;
+                    const Reloj::time_point antes = Reloj::now();
+                    if (cola.desencolar(elemento, c)) {
+                        propias.push_back(nanosegundos(antes, Reloj::now()));
+                    } else if (terminado.load(std::memory_order_acquire) && cola.vacia()) {
+                        break;
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+
+        const Reloj::time_point comienzo = Reloj::now();
+        inicio.store(true, std::memory_order_release);
+        for (char& elemento : elementos) {
+            for (;;) {
+                const Reloj::time_point antes = Reloj::now();
+                if (cola.encolar(&elemento)) {
+                    encolados.push_back(nanosegundos(antes, Reloj::now()));
+                    break;
+                }
+                std::this_thread::yield();
+            }
+        }
+        terminado.store(true, std::memory_order_release);
+        for (std::thread& hilo : hilos) {
+            hilo.join();
+        }
+        const double segundos = std::chrono::duration<double>(Reloj::now() - comienzo).count();
+
+        std::vector<std::int64_t> todas;
+        todas.reserve(opciones.elementos);
+        for (const std::vector<std::int64_t>& propias : desencolados) {
+            todas.insert(todas.end(), propias.begin(), propias.end());
+        }
+        return Medicion{static_cast<double> (todas.size()) / segundos, percentiles(encolados), percentiles(todas), todas.size()};
+    }
+}
+
+int main(int argc, char** argv) {
+    OpcionesBanco opciones;
+    if (!parsear(argc, argv, opciones)) {
+        return EXIT_FAILURE;
+    }
+
+    std::cout << std::left << std::setw(14) << "cola" << std::right << std::setw(13) << "consumidores"
+            << std::setw(10) << "Melem/s" << std::setw(10) << "enc p50" << std::setw(10) << "enc p99" << std::setw(10) << "enc p999"
+            << std::setw(10) << "des p50" << std::setw(10) << "des p99" << std::setw(10) << "des p999" << "  (ns por llamada)\n";
+    bool completo = true;
+    for (const edad::TipoCola tipo : opciones.colas) {
+        for (std::size_t consumidores = 1u; consumidores <= opciones.consumidores; ++consumidores) {
+            const Medicion medicion = medir(tipo, consumidores, opciones);
+            std::cout << std::left << std::setw(14) << edad::nombre_cola(tipo) << std::right << std::setw(13) << consumidores
+                    << std::setw(10) << std::fixed << std::setprecision(2) << medicion.elementos_por_segundo / 1e6
+                    << std::setw(10) << medicion.encolar.p50 << std::setw(10) << medicion.encolar.p99
+                    << std::setw(10) << medicion.encolar.p999 << std::setw(10) << medicion.desencolar.p50
+                    << std::setw(10) << medicion.desencolar.p99 << std::setw(10) << medicion.desencolar.p999 << "\n";
+            if (medicion.recibidos != opciones.elementos) {
+                std::cerr << edad::nombre_cola(tipo) << ": se recibieron " << medicion.recibidos << " de " << opciones.elementos
+                        << " elementos\n";
+                completo = false;
+            }
+        }
+    }
+    return completo ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,265 @@
+/**
+ * @file
+ * @brief Herramienta: reescribe un archivo de líneas (texto o `.xz`) como `.xz` de varios bloques cortados en '\n'.
+ *
+ * @details
+ * Los motores de `paralelo` decodifican en paralelo los bloques de un `.xz` (ver LectorXz.h), pero un archivo
+ * comprimido con `xz` sin hilos tiene un único bloque, y `xz -T0` corta los bloques en cualquier byte
+ * (las líneas de borde deben reconstruirse aparte). Esta herramienta usa el codificador multihilo de
+ * liblzma (`lzma_stream_encoder_mt`) y cierra cada bloque con `LZMA_FULL_BARRIER` justo después de un '\n',
+ * de modo que cada bloque contiene solo líneas completas.
+ *
+ * ### Tamaño de bloque
+ * - Bloques más chicos ⇒ más bloques para repartir entre hilos y menos memoria por búfer al leer
+ *   (cada búfer del lector ocupa un bloque descomprimido), a costa de algo de razón de compresión
+ *   (el diccionario se reinicia en cada bloque).
+ * - Por omisión 4 MiB: edades.csv (≈106 MiB) queda en ≈27 bloques, suficientes para repartir entre
+ *   decenas de hilos, y el archivo crece ≈3 % (22,8 MB frente a 22,2 MB del original de 5 bloques de 24 MiB).
+ *
+ * ### Uso
+ * @code{.bash}
+ * ./recomprimir [--bloque=MiB] [--nivel=0-9] [--hilos=N] entrada salida.xz
+ * ./recomprimir edades.csv.xz edades-bloques.csv.xz
+ * xz -lv edades-bloques.csv.xz   # verificar bloques
+ * @endcode
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include <lzma.h>
+
+#include "Lector.h"
+#include "LectorXz.h"
+
+namespace {
+
+    /// Configuración de la herramienta.
+    struct OpcionesRecomprimir {
+        std::string entrada;
+        std::string salida;
+        std::size_t bloque = std::size_t{4} << 20;
+        std::uint32_t nivel = 6u;
+        std::uint32_t hilos = 0u; ///< 0: todos los núcleos disponibles.
+    };
+
+    /// Interpreta un entero positivo de `--nombre=valor`; informa el problema por @c std::cerr.
+    bool valor_numerico(const std::string& argumento, const std::string& prefijo, unsigned long& valor, bool& coincide) {
+        coincide = argumento.compare(0, prefijo.size(), prefijo) == 0;
+        if (!coincide) {
+            return true;
+        }
+        const std::string texto = argumento.substr(prefijo.size());
+        std::size_t usados = 0u;
+        try {
+            valor = std::stoul(texto, &usados);
+        } catch (const std::exception&) {
+            usados = 0u;
+        }
+        if (usados == 0u || usados != texto.size()) {
+            std::cerr << "Valor inválido en " << argumento << "\n";
+            return false;
+        }
+        return true;
+    }
+
+    bool parsear(int argc, char** argv, OpcionesRecomprimir& opciones) {
+        for (int i = 1; i < argc; ++i) {
+            const std::string argumento = argv[i];
+            unsigned long valor = 0u;
+            bool coincide = false;
+            if (!valor_numerico(argumento, "--bloque=", valor, coincide)) {
+                return false;
+            } else if (coincide) {
+                if (valor == 0u || valor > 1024u) {
+                    std::cerr << "Tamaño de bloque fuera de [1, 1024] MiB: " << valor << "\n";
+                    return false;
+                }
+                opciones.bloque = static_cast<std::size_t> (valor) << 20;
+            } else if (!valor_numerico(argumento, "--nivel=", valor, coincide)) {
+                return false;
+            } else if (coincide) {
+                if (valor > 9u) {
+                    std::cerr << "Nivel fuera de [0, 9]: " << valor << "\n";
+                    return false;
+                }
+                opciones.nivel = static_cast<std::uint32_t> (valor);
+            } else if (!valor_numerico(argumento, "--hilos=", valor, coincide)) {
+                return false;
+            } else if (coincide) {
+                opciones.hilos = static_cast<std::uint32_t> (valor);
+            } else if (argumento.compare(0, 2, "--") == 0) {
+                std::cerr << "Opción desconocida: " << argumento << "\n";
+                return false;
+            } else if (opciones.entrada.empty()) {
+                opciones.entrada = argumento;
+            } else if (opciones.salida.empty()) {
+                opciones.salida = argumento;
+            } else {
+                std::cerr << "Argumento inesperado: " << argumento << "\n";
+                return false;
+            }
+        }
+        if (opciones.salida.empty()) {
+            std::cerr << "Uso: " << argv[0] << " [--bloque=MiB] [--nivel=0-9] [--hilos=N] entrada salida.xz\n";
+            return false;
+        }
+        if (opciones.hilos == 0u) {
+            opciones.hilos = std::max(1u, std::thread::hardware_concurrency());
+        }
+        return true;
+    }
+
+    /**
+     * @brief Codificador multihilo que cierra bloques solo en bordes de línea.
+     */
+    class Compresor {
+    public:
+        Compresor(const OpcionesRecomprimir& opciones, std::ofstream& salida)
+        : salida_(salida), bloque_(opciones.bloque) {
+            lzma_mt configuracion{};
+            configuracion.threads = opciones.hilos;
+            // Los cortes los decide LZMA_FULL_BARRIER; el límite del codificador solo actúa con líneas gigantes.
+            configuracion.block_size = 2u * opciones.bloque;
+            configuracion.preset = opciones.nivel;
+            configuracion.check = LZMA_CHECK_CRC64;
+            if (lzma_stream_encoder_mt(&flujo_, &configuracion) != LZMA_OK) {
+                throw std::runtime_error("no se pudo inicializar el codificador xz");
+            }
+        }
+
+        ~Compresor() {
+            lzma_end(&flujo_);
+        }
+
+        Compresor(const Compresor&) = delete;
+        Compresor& operator=(const Compresor&) = delete;
+
+        /// Agrega @p texto (líneas completas salvo quizás al final del archivo), cortando bloques en '\n'.
+        void agregar(std::string_view texto) {
+            while (!texto.empty()) {
+                const std::size_t espacio = bloque_ - acumulado_;
+                if (texto.size() < espacio) {
+                    codificar(texto, LZMA_RUN);
+                    acumulado_ += texto.size();
+                    return;
+                }
+                // Último '\n' que cabe en el bloque; si no hay, el primero después (línea más larga que el espacio).
+                std::size_t corte = texto.rfind('\n', espacio - 1u);
+                if (corte == std::string_view::npos) {
+                    corte = texto.find('\n', espacio);
+                }
+                if (corte == std::string_view::npos) {
+                    codificar(texto, LZMA_RUN);
+                    acumulado_ += texto.size();
+                    return;
+                }
+                codificar(texto.substr(0u, corte + 1u), LZMA_RUN);
+                codificar(std::string_view(), LZMA_FULL_BARRIER);
+                ++bloques_;
+                acumulado_ = 0u;
+                texto.remove_prefix(corte + 1u);
+            }
+        }
+
+        /// Cierra el último bloque y el stream.
+        void terminar() {
+            codificar(std::string_view(), LZMA_FINISH);
+            if (acumulado_ > 0u) {
+                ++bloques_;
+            }
+        }
+
+        std::size_t bloques() const noexcept {
+            return bloques_;
+        }
+
+        std::uint64_t entrada() const noexcept {
+            return flujo_.total_in;
+        }
+
+        std::uint64_t salida() const noexcept {
+            return flujo_.total_out;
+        }
+
+    private:
+        void codificar(std::string_view texto, lzma_action accion) {
+            flujo_.next_in = reinterpret_cast<const std::uint8_t*> (texto.data());
+            flujo_.avail_in = texto.size();
+            for (;;) {
+                flujo_.next_out = reinterpret_cast<std::uint8_t*> (bufer_);
+                flujo_.avail_out = sizeof (bufer_);
+                const lzma_ret codigo = lzma_code(&flujo_, accion);
+                salida_.write(bufer_, static_cast<std::streamsize> (sizeof (bufer_) - flujo_.avail_out));
+                if (codigo == LZMA_STREAM_END) {
+                    return; // barrera o fin completados
+                }
+                if (codigo != LZMA_OK) {
+                    throw std::runtime_error("error del codificador xz");
+                }
+                if (accion == LZMA_RUN && flujo_.avail_in == 0u) {
+                    return;
+                }
+            }
+        }
+
+        lzma_stream flujo_ = LZMA_STREAM_INIT;
+        std::ofstream& salida_;
+        std::size_t bloque_;
+        std::size_t acumulado_ = 0u;
+        std::size_t bloques_ = 0u;
+        char bufer_[1u << 16];
+    };
+}
+
+int main(int argc, char** argv) {
+    OpcionesRecomprimir opciones;
+    if (!parsear(argc, argv, opciones)) {
+        return EXIT_FAILURE;
+    }
+
+    std::ofstream salida(opciones.salida, std::ios::binary | std::ios::trunc);
+    if (!salida) {
+        std::cerr << "No se pudo crear: " << opciones.salida << "\n";
+        return EXIT_FAILURE;
+    }
+
+    try {
+        Compresor compresor(opciones, salida);
+        if (edad::es_flujo(opciones.entrada)) {
+            // Los trozos del lector contienen solo líneas completas: los cortes de bloque caen siempre en '\n'.
+            edad::LectorXz lector(opciones.entrada);
+            edad::TrozoXz trozo;
+            while (lector.tomar(trozo)) {
+                compresor.agregar(trozo.texto);
+                lector.devolver(trozo);
+            }
+            if (!lector.error().empty()) {
+                std::cerr << "No se pudo leer: " << opciones.entrada << ": " << lector.error() << "\n";
+                return EXIT_FAILURE;
+            }
+        } else {
+            const edad::ArchivoMapeado archivo(opciones.entrada);
+            compresor.agregar(archivo.contenido());
+        }
+        compresor.terminar();
+        salida.flush();
+        if (!salida) {
+            std::cerr << "No se pudo escribir: " << opciones.salida << "\n";
+            return EXIT_FAILURE;
+        }
+        std::cerr << opciones.salida << ": " << compresor.bloques() << " bloques, " << compresor.entrada()
+                << " -> " << compresor.salida() << " bytes\n";
+    } catch (const std::runtime_error& error) {
+        std::cerr << "No se pudo recomprimir: " << error.what() << "\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}